@@ -58,4 +58,33 @@ namespace embree
   };
 
   parallel_for_regression_test parallel_for_regression("parallel_for_regression_test");
+
+  struct parallel_for_recursion_regression_test : public RegressionTest
+  {
+    parallel_for_recursion_regression_test(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    /* nests parallel_for calls, each nesting level keeps multiple tasks on the task stack */
+    static size_t nest(size_t depth)
+    {
+      if (depth == 0) return 1;
+      std::atomic<size_t> n(0);
+      parallel_for( size_t(0), size_t(2), size_t(1), [&](const range<size_t>& r) 
+      {
+        for (size_t i=r.begin(); i<r.end(); i++)
+          n += i == 0 ? nest(depth-1) : 1;
+      });
+      return n;
+    }
+    
+    bool run ()
+    {
+      /* exceeds the first task stack segment */
+      const size_t depth = 1024;
+      return nest(depth) == depth+1;
+    }
+  };
+
+  parallel_for_recursion_regression_test parallel_for_recursion_regression("parallel_for_recursion_regression_test");
 }
@@ -21,15 +21,15 @@
 
 namespace embree
 {
-  /* serial partitioning */
+  /* serial partitioning of small ranges */
   template<typename T, typename V, typename IsLeft, typename Reduction_T>
-    __forceinline size_t serial_partitioning(T* array, 
-                                             const size_t begin,
-                                             const size_t end, 
-                                             V& leftReduction,
-                                             V& rightReduction,
-                                             const IsLeft& is_left, 
-                                             const Reduction_T& reduction_t)
+    __forceinline size_t serial_partitioning_scalar(T* array, 
+                                                    const size_t begin,
+                                                    const size_t end, 
+                                                    V& leftReduction,
+                                                    V& rightReduction,
+                                                    const IsLeft& is_left, 
+                                                    const Reduction_T& reduction_t)
   {
     T* l = array + begin;
     T* r = array + end - 1;
@@ -61,6 +61,85 @@ namespace embree
     return l - array;        
   }
 
+  /* Serial partitioning that classifies blocks of items from both ends
+   * without branches. The offsets of items on the wrong side get
+   * written unconditionally to a buffer and only the buffer size depends
+   * on the classification, thus mispredicted branches per item are
+   * avoided. Items on the wrong side of both blocks are then swapped in
+   * pairs. */
+  template<typename T, typename V, typename IsLeft, typename Reduction_T>
+    __forceinline size_t serial_partitioning(T* array, 
+                                             const size_t begin,
+                                             const size_t end, 
+                                             V& leftReduction,
+                                             V& rightReduction,
+                                             const IsLeft& is_left, 
+                                             const Reduction_T& reduction_t)
+  {
+    static const size_t BLOCK_SIZE = 64;
+    if (end-begin < 4*BLOCK_SIZE)
+      return serial_partitioning_scalar(array,begin,end,leftReduction,rightReduction,is_left,reduction_t);
+
+    unsigned int offsetsL[BLOCK_SIZE]; // items of left block that belong to the right
+    unsigned int offsetsR[BLOCK_SIZE]; // items of right block that belong to the left
+    size_t startL = 0, numL = 0;
+    size_t startR = 0, numR = 0;
+    T* blockL = nullptr;
+    T* blockR = nullptr;
+    T* l = array + begin; // start of unclassified items
+    T* r = array + end;   // end of unclassified items
+
+    while (true)
+    {
+      if (numL == 0 && size_t(r-l) >= BLOCK_SIZE)
+      {
+        startL = 0; blockL = l; l += BLOCK_SIZE;
+        for (size_t i=0; i<BLOCK_SIZE; i++) {
+          const bool left = is_left(blockL[i]);
+          reduction_t(left ? leftReduction : rightReduction,blockL[i]);
+          offsetsL[numL] = (unsigned int) i; numL += !left;
+        }
+      }
+
+      if (numR == 0 && size_t(r-l) >= BLOCK_SIZE)
+      {
+        startR = 0; r -= BLOCK_SIZE; blockR = r;
+        for (size_t i=0; i<BLOCK_SIZE; i++) {
+          const bool left = is_left(blockR[i]);
+          reduction_t(left ? leftReduction : rightReduction,blockR[i]);
+          offsetsR[numR] = (unsigned int) i; numR += left;
+        }
+      }
+
+      const size_t num = min(numL,numR);
+      for (size_t i=0; i<num; i++)
+        xchg(blockL[offsetsL[startL+i]],blockR[offsetsR[startR+i]]);
+      startL += num; numL -= num;
+      startR += num; numR -= num;
+
+      /* stop when an empty buffer cannot get refilled */
+      if ((numL == 0 || numR == 0) && size_t(r-l) < BLOCK_SIZE) break;
+    }
+
+    /* partition the remaining unclassified items */
+    size_t mid = serial_partitioning_scalar(array,l-array,r-array,leftReduction,rightReduction,is_left,reduction_t);
+
+    /* move remaining misplaced items of the left block to the right side */
+    for (ssize_t i=ssize_t(numL)-1; i>=0; i--) {
+      T* item = blockL+offsetsL[startL+i];
+      if (item != &array[--mid]) xchg(*item,array[mid]);
+    }
+
+    /* move remaining misplaced items of the right block to the left side */
+    for (size_t i=0; i<numR; i++) {
+      T* item = blockR+offsetsR[startR+i];
+      if (item != &array[mid]) xchg(*item,array[mid]);
+      mid++;
+    }
+    
+    return mid;
+  }
+
   template<typename T, typename V, typename Vi, typename IsLeft, typename Reduction_T, typename Reduction_V>
     class __aligned(64) parallel_partition_task
   {
@@ -77,6 +156,7 @@ namespace embree
     const Vi& identity;
 
     size_t numTasks; 
+    size_t blockSize;
     __aligned(64) size_t counter_start[MAX_TASKS+1]; 
     __aligned(64) size_t counter_left[MAX_TASKS+1];  
     __aligned(64) range<ssize_t> leftMisplacedRanges[MAX_TASKS];  
@@ -95,7 +175,7 @@ namespace embree
                                           const size_t BLOCK_SIZE) 
 
       : array(array), N(N), is_left(is_left), reduction_t(reduction_t), reduction_v(reduction_v), identity(identity),
-      numTasks(min((N+BLOCK_SIZE-1)/BLOCK_SIZE,min(TaskScheduler::threadCount(),MAX_TASKS))) {}
+      numTasks(min((N+BLOCK_SIZE-1)/BLOCK_SIZE,min(TaskScheduler::threadCount(),MAX_TASKS))), blockSize(BLOCK_SIZE) {}
 
     __forceinline const range<ssize_t>* findStartRange(size_t& index, const range<ssize_t>* const r, const size_t numRanges)
     {
@@ -216,10 +296,16 @@ namespace embree
       if (numMisplacedItemsLeft == 0)
         return mid;
 
-      /* otherwise we copy the items to the right place in parallel */
-      parallel_for(numTasks,[&] (const size_t taskID) {
-          const size_t startID = (taskID+0)*numMisplacedItemsLeft/numTasks;
-          const size_t endID   = (taskID+1)*numMisplacedItemsLeft/numTasks;
+      /* otherwise we copy the items to the right place, spawning only as many tasks as there are blocks of misplaced items */
+      const size_t numSwapTasks = min(numTasks,(numMisplacedItemsLeft+blockSize-1)/blockSize);
+      if (numSwapTasks == 1) {
+        swapItemsInMisplacedRanges(numMisplacedRangesLeft,numMisplacedRangesRight,0,numMisplacedItemsLeft);
+        return mid;
+      }
+      
+      parallel_for(numSwapTasks,[&] (const size_t taskID) {
+          const size_t startID = (taskID+0)*numMisplacedItemsLeft/numSwapTasks;
+          const size_t endID   = (taskID+1)*numMisplacedItemsLeft/numSwapTasks;
           swapItemsInMisplacedRanges(numMisplacedRangesLeft,numMisplacedRangesRight,startID,endID);	                             
         });
 
@@ -36,13 +36,18 @@ namespace embree
     const size_t numBlocks  = (last-first+minStepSize-1)/minStepSize;
     const size_t taskCount  = min(numThreads,numBlocks,size_t(ParallelPrefixSumState<Value>::MAX_TASKS));
 
-    /* perform parallel prefix sum */
-    parallel_for(taskCount, [&](const size_t taskIndex)
+    /* perform parallel prefix sum, a single task runs without spawning */
+    if (taskCount == 1)
+      state.counts[0] = func(range<size_t>(first,last),state.sums[0]);
+    else
     {
-      const size_t i0 = first+(taskIndex+0)*(last-first)/taskCount;
-      const size_t i1 = first+(taskIndex+1)*(last-first)/taskCount;
-      state.counts[taskIndex] = func(range<size_t>(i0,i1),state.sums[taskIndex]);
-    });
+      parallel_for(taskCount, [&](const size_t taskIndex)
+      {
+        const size_t i0 = first+(taskIndex+0)*(last-first)/taskCount;
+        const size_t i1 = first+(taskIndex+1)*(last-first)/taskCount;
+        state.counts[taskIndex] = func(range<size_t>(i0,i1),state.sums[taskIndex]);
+      });
+    }
 
     /* calculate prefix sum */
     Value sum=identity;
@@ -113,6 +113,23 @@ namespace embree
   template<typename T> __forceinline Vec3<T> xfmVector( const QuaternionT<T>& a, const Vec3<T>&       b ) { return (a*QuaternionT<T>(b)*conj(a)).v(); }
   template<typename T> __forceinline Vec3<T> xfmNormal( const QuaternionT<T>& a, const Vec3<T>&       b ) { return (a*QuaternionT<T>(b)*conj(a)).v(); }
 
+  template<typename T> __forceinline T dot(const QuaternionT<T>& a, const QuaternionT<T>& b) { return a.r*b.r + a.i*b.i + a.j*b.j + a.k*b.k; }
+
+  /*! spherical linear interpolation of two unit quaternions, the
+   *  signs of the quaternions select along which arc to interpolate */
+  template<typename T> __forceinline QuaternionT<T> slerp(const QuaternionT<T>& q0, const QuaternionT<T>& q1, const T& t)
+  {
+    const T cosTheta = dot(q0,q1);
+
+    /* fall back to normalized linear interpolation for nearly identical rotations */
+    if (cosTheta > T(0.9995f))
+      return normalize((T(one)-t)*q0 + t*q1);
+
+    const T theta = acos(cosTheta);
+    const T rcpSinTheta = T(one)/sin(theta);
+    return (sin((T(one)-t)*theta)*rcpSinTheta)*q0 + (sin(t*theta)*rcpSinTheta)*q1;
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
   /// Comparison Operators
   ////////////////////////////////////////////////////////////////////////////////
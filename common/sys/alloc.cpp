@@ -120,7 +120,13 @@ namespace embree
     return true;
   }
 
-  void* os_malloc(size_t bytes, bool& hugepages)
+  bool os_init_transparent_hugepages(bool verbose)
+  {
+    if (verbose) std::cout << "WARNING: Transparent huge pages are only supported under Linux!" << std::endl;
+    return false;
+  }
+
+  void* os_malloc(size_t bytes, bool& hugepages, bool transparent_hugepages)
   {
     if (bytes == 0) {
       hugepages = false;
@@ -146,7 +152,7 @@ namespace embree
     return ptr;
   }
 
-  size_t os_shrink(void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages) 
+  size_t os_shrink(void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages, bool transparent_hugepages) 
   {
     if (hugepages) // decommitting huge pages seems not to work under Windows
       return bytesOld;
@@ -246,7 +252,25 @@ namespace embree
     return true;
   }
 
-  void* os_malloc(size_t bytes, bool& hugepages)
+  bool os_init_transparent_hugepages(bool verbose)
+  {
+#if defined(__LINUX__)
+    /* transparent huge pages are not available if disabled system wide */
+    std::ifstream file;
+    file.open("/sys/kernel/mm/transparent_hugepage/enabled",std::ios::in);
+    std::string mode;
+    if (!file.is_open() || !getline(file,mode) || mode.find("[never]") != std::string::npos) {
+      if (verbose) std::cout << "WARNING: Transparent huge pages are disabled. Transparent huge page support cannot get enabled!" << std::endl;
+      return false;
+    }
+    return true;
+#else
+    if (verbose) std::cout << "WARNING: Transparent huge pages are only supported under Linux!" << std::endl;
+    return false;
+#endif
+  }
+
+  void* os_malloc(size_t bytes, bool& hugepages, bool transparent_hugepages)
   { 
     if (bytes == 0) {
       hugepages = false;
@@ -271,6 +295,23 @@ namespace embree
 #endif
     } 
 
+    /* transparent huge pages require 2MB aligned mappings that cover full 2MB pages */
+    if (transparent_hugepages && bytes >= PAGE_SIZE_2M)
+    {
+      const size_t hbytes = (bytes+PAGE_SIZE_2M-1) & ~size_t(PAGE_SIZE_2M-1);
+      char* ptr = (char*) mmap(0, hbytes+PAGE_SIZE_2M, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+      if (ptr == MAP_FAILED) throw std::bad_alloc();
+
+      /* unmap the unaligned start and end of the mapping */
+      char* aptr = (char*) ((size_t(ptr)+PAGE_SIZE_2M-1) & ~size_t(PAGE_SIZE_2M-1));
+      if (aptr != ptr) munmap(ptr,aptr-ptr);
+      if (aptr+hbytes != ptr+hbytes+PAGE_SIZE_2M) munmap(aptr+hbytes,(ptr+hbytes+PAGE_SIZE_2M)-(aptr+hbytes));
+
+      hugepages = true;
+      os_advise(aptr,hbytes);
+      return aptr;
+    }
+
     /* fallback to 4k pages */
     void* ptr = (char*) mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
     if (ptr == MAP_FAILED) throw std::bad_alloc();
@@ -281,11 +322,20 @@ namespace embree
     return ptr;
   }
 
-  size_t os_shrink(void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages) 
+  size_t os_shrink(void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages, bool transparent_hugepages) 
   {
     const size_t pageSize = hugepages ? PAGE_SIZE_2M : PAGE_SIZE_4K;
+    const size_t bytesUsed = (bytesNew+PAGE_SIZE_4K-1) & ~size_t(PAGE_SIZE_4K-1);
     bytesNew = (bytesNew+pageSize-1) & ~(pageSize-1);
     bytesOld = (bytesOld+pageSize-1) & ~(pageSize-1);
+
+    /* the last transparent huge page gets split to return its unused 4KB pages */
+#if defined(MADV_DONTNEED)
+    const size_t bytesKept = bytesNew < bytesOld ? bytesNew : bytesOld;
+    if (hugepages && transparent_hugepages && bytesUsed < bytesKept)
+      madvise((char*)ptr+bytesUsed,bytesKept-bytesUsed,MADV_DONTNEED);
+#endif
+
     if (bytesNew >= bytesOld)
       return bytesOld;
 
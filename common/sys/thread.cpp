@@ -139,6 +139,11 @@ namespace embree
     CloseHandle(HANDLE(tid));
   }
 
+  /*! releases the handle of a hardware thread */
+  void detachThread(thread_t tid) {
+    CloseHandle(HANDLE(tid));
+  }
+
   /*! creates thread local storage */
   tls_t createTls() {
     return tls_t(size_t(TlsAlloc()));
@@ -383,6 +388,13 @@ namespace embree
     delete (pthread_t*)tid;
   }
 
+  /*! releases the handle of a hardware thread */
+  void detachThread(thread_t tid) {
+    if (pthread_detach(*(pthread_t*)tid) != 0)
+      FATAL("pthread_detach failed");
+    delete (pthread_t*)tid;
+  }
+
   /*! creates thread local storage */
   tls_t createTls() 
   {
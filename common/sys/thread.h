@@ -45,6 +45,9 @@ namespace embree
   /*! destroy handle of a thread */
   void destroyThread(thread_t tid);
 
+  /*! releases the handle of a thread, the thread frees its resources when it terminates */
+  void detachThread(thread_t tid);
+
   /*! type for handle to thread local storage */
   typedef struct opaque_tls_t* tls_t;
 
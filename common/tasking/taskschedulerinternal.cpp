@@ -18,6 +18,7 @@
 #include "../math/math.h"
 #include "../sys/sysinfo.h"
 #include <algorithm>
+#include <limits>
 
 namespace embree
 {
@@ -83,23 +84,63 @@ namespace embree
     run_internal(thread);
   }
 
+  __dllexport TaskScheduler::TaskQueue::TaskQueue ()
+    : left(0), right(0), stackPtr(0)
+  {
+    taskSegments[0] = tasks;
+    closureSegments[0] = stack;
+    for (size_t k=1; k<MAX_STACK_SEGMENTS; k++) {
+      taskSegments[k] = nullptr;
+      closureSegments[k] = nullptr;
+    }
+  }
+
+  __dllexport TaskScheduler::TaskQueue::~TaskQueue ()
+  {
+    for (size_t k=1; k<MAX_STACK_SEGMENTS; k++) {
+      alignedFree(taskSegments[k]);
+      alignedFree(closureSegments[k]);
+    }
+  }
+
+  __dllexport void TaskScheduler::TaskQueue::allocTaskSegment(size_t segment)
+  {
+    if (segment >= MAX_STACK_SEGMENTS)
+      throw std::runtime_error("task stack overflow");
+    
+    const size_t N = TASK_STACK_SIZE << segment;
+    Task* tasks = (Task*) alignedMalloc(N*sizeof(Task),64);
+    for (size_t i=0; i<N; i++) new (&tasks[i]) Task;
+
+    /* publish segment before the right pointer passes its first task */
+    taskSegments[segment].store(tasks);
+  }
+
+  __dllexport void TaskScheduler::TaskQueue::allocClosureSegment(size_t segment)
+  {
+    if (segment >= MAX_STACK_SEGMENTS)
+      throw std::runtime_error("closure stack overflow");
+    
+    closureSegments[segment] = (char*) alignedMalloc(CLOSURE_STACK_SIZE << segment,64);
+  }
+
   bool TaskScheduler::TaskQueue::execute_local_internal(Thread& thread, Task* parent)
   {
     /* stop if we run out of local tasks or reach the waiting task */
-    if (right == 0 || &tasks[right-1] == parent)
+    if (right == 0 || &task(right-1) == parent)
       return false;
 
     /* execute task */
     size_t oldRight = right;
-    tasks[right-1].run_internal(thread);
+    task(right-1).run_internal(thread);
     if (right != oldRight) {
       THROW_RUNTIME_ERROR("you have to wait for spawned subtasks");
     }
 
     /* pop task and closure from stack */
     right--;
-    if (tasks[right].stackPtr != size_t(-1))
-      stackPtr = tasks[right].stackPtr;
+    if (task(right).stackPtr != size_t(-1))
+      stackPtr = task(right).stackPtr;
 
     /* also move left pointer */
     if (left >= right) left.store(right.load());
@@ -119,22 +160,32 @@ namespace embree
     else
       return false;
 
-    if (!tasks[l].try_steal(thread.tasks.tasks[thread.tasks.right]))
+    /* concurrent thieves may move left past right, all segments up to right exist */
+    if (l >= right)
       return false;
 
-    thread.tasks.right++;
+    TaskQueue& local = thread.tasks;
+    local.reserve(local.right);
+    if (!task(l).try_steal(local.task(local.right)))
+      return false;
+
+    local.right++;
     return true;
   }
 
   /* we steal from the left */
   size_t TaskScheduler::TaskQueue::getTaskSizeAtLeft()
   {
-    if (left >= right) return 0;
-    return tasks[left].N;
+    size_t l = left;
+    if (l >= right) return 0;
+    return task(l).N;
   }
 
   static MutexSys g_mutex;
 
+  /*! joined threads the calling application thread belongs to, nullptr for all other threads */
+  static __thread TaskScheduler::JoinedThreads* g_joined_threads = nullptr;
+
   void threadPoolFunction(std::pair<TaskScheduler::ThreadPool*,size_t>* pair)
   {
     TaskScheduler::ThreadPool* pool = pair->first;
@@ -144,32 +195,34 @@ namespace embree
   }
 
   TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+    : topPriority(std::numeric_limits<int>::min()), numThreads(0), numUserThreads(0), numThreadsRunning(0), numJoinedThreads(0), terminating(false), set_affinity(set_affinity), running(false) {}
 
   __dllexport void TaskScheduler::ThreadPool::startThreads()
   {
     if (running) return;
-    setNumThreads(numThreads,true);
+    setNumThreads(numThreads,numUserThreads,true);
   }
 
-  void TaskScheduler::ThreadPool::setNumThreads(size_t newNumThreads, bool startThreads)
+  void TaskScheduler::ThreadPool::setNumThreads(size_t newNumThreads, size_t newNumUserThreads, bool startThreads)
   {
     Lock<MutexSys> lock(g_mutex);
     assert(newNumThreads);
     newNumThreads = min(newNumThreads, (size_t) getNumberOfLogicalThreads());
 
     numThreads = newNumThreads;
+    numUserThreads = min(newNumUserThreads, newNumThreads-1);
     if (!startThreads && !running) return;
     running = true;
     size_t numThreadsActive = numThreadsRunning;
 
+    /* the slots of application threads are not backed by own threads */
     mutex.lock();
-    numThreadsRunning = newNumThreads;
+    numThreadsRunning = numThreads-numUserThreads;
     mutex.unlock();
     condition.notify_all();
 
     /* start new threads */
-    for (size_t t=numThreadsActive; t<numThreads; t++)
+    for (size_t t=numThreadsActive; t<numThreadsRunning; t++)
     {
       if (t == 0) continue;
       auto pair = new std::pair<TaskScheduler::ThreadPool*,size_t>(this,t);
@@ -189,18 +242,25 @@ namespace embree
     /* leave all taskschedulers */
     mutex.lock();
     numThreadsRunning = 0;
+    terminating = true;
     mutex.unlock();
     condition.notify_all();
 
     /* wait for threads to terminate */
     for (size_t i=0; i<threads.size(); i++)
       embree::join(threads[i]);
+
+    /* wait for application threads to return */
+    while (numJoinedThreads > 0) yield();
   }
 
   __dllexport void TaskScheduler::ThreadPool::add(const Ref<TaskScheduler>& scheduler)
   {
     mutex.lock();
-    schedulers.push_back(scheduler);
+    std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin();
+    while (it != schedulers.end() && (*it)->priority >= scheduler->priority) it++;
+    schedulers.insert(it,scheduler);
+    updatePriority();
     mutex.unlock();
     condition.notify_all();
   }
@@ -211,11 +271,27 @@ namespace embree
     for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
       if (scheduler == *it) {
         schedulers.erase(it);
+        updatePriority();
         return;
       }
     }
   }
 
+  Ref<TaskScheduler> TaskScheduler::ThreadPool::select()
+  {
+    for (auto& scheduler : schedulers)
+      if (scheduler->hasFreeThreadSlot()) return scheduler;
+    return null;
+  }
+
+  void TaskScheduler::ThreadPool::updatePriority()
+  {
+    int top = std::numeric_limits<int>::min();
+    for (auto& scheduler : schedulers)
+      if (scheduler->hasFreeThreadSlot()) top = max(top,scheduler->priority);
+    topPriority = top;
+  }
+
   void TaskScheduler::ThreadPool::thread_loop(size_t globalThreadIndex)
   {
     while (globalThreadIndex < numThreadsRunning)
@@ -224,24 +300,80 @@ namespace embree
       ssize_t threadIndex = -1;
       {
         Lock<MutexSys> lock(mutex);
-        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || !schedulers.empty(); });
+        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || (scheduler = select()) != null; });
         if (globalThreadIndex >= numThreadsRunning) break;
-        scheduler = schedulers.front();
         threadIndex = scheduler->allocThreadIndex();
+        updatePriority();
+      }
+      if (threadIndex < 0) continue;
+      scheduler->thread_loop(threadIndex,true);
+
+      /* leaving threads free a slot of the scheduler */
+      {
+        Lock<MutexSys> lock(mutex);
+        updatePriority();
       }
-      scheduler->thread_loop(threadIndex);
+      condition.notify_all();
     }
   }
 
-  TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false)
+  __dllexport void TaskScheduler::ThreadPool::join(JoinedThreads& joined)
+  {
+    mutex.lock();
+    numJoinedThreads++;
+    joined.numThreads++;
+    mutex.unlock();
+    g_joined_threads = &joined;
+
+    while (true)
+    {
+      Ref<TaskScheduler> scheduler = NULL;
+      ssize_t threadIndex = -1;
+      {
+        Lock<MutexSys> lock(mutex);
+        condition.wait(mutex, [&] () { return isLeaving() || (scheduler = select()) != null; });
+        if (isLeaving()) break;
+        threadIndex = scheduler->allocThreadIndex();
+        updatePriority();
+      }
+      if (threadIndex < 0) continue;
+      scheduler->thread_loop(threadIndex,true);
+
+      /* leaving threads free a slot of the scheduler */
+      {
+        Lock<MutexSys> lock(mutex);
+        updatePriority();
+      }
+      condition.notify_all();
+    }
+
+    /* the joined threads may get destroyed as soon as their count reaches zero, the pool waits for its count */
+    g_joined_threads = nullptr;
+    joined.numThreads--;
+    numJoinedThreads--;
+  }
+
+  __dllexport void TaskScheduler::ThreadPool::leave(JoinedThreads& joined)
+  {
+    mutex.lock();
+    joined.leaving = true;
+    mutex.unlock();
+    condition.notify_all();
+  }
+
+  bool TaskScheduler::ThreadPool::isLeaving() const {
+    return g_joined_threads && (g_joined_threads->leaving || terminating);
+  }
+
+  __dllexport TaskScheduler::TaskScheduler()
+    : numFreeThreadIndices(0), threadCounter(0), threadIndexCounter(0), priority(0), maxThreads(0), anyTasksRunning(0), hasRootTask(false)
   {
     threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the compatibility join mode with rtcCommitScene the worker threads also join. When disallowing rtcCommitScene to join a build we can remove the 2x.
     for (size_t i=0; i<threadLocal.size(); i++)
       threadLocal[i].store(nullptr);
   }
 
-  TaskScheduler::~TaskScheduler()
+  __dllexport TaskScheduler::~TaskScheduler()
   {
     assert(threadCounter == 0);
   }
@@ -273,33 +405,71 @@ namespace embree
     return g_instance;
   }
 
-  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads)
+  void TaskScheduler::create(size_t numThreads, size_t numUserThreads, bool set_affinity, bool start_threads)
   {
     if (!threadPool) threadPool = new TaskScheduler::ThreadPool(set_affinity);
-    threadPool->setNumThreads(numThreads,start_threads);
+    threadPool->setNumThreads(numThreads,numUserThreads,start_threads);
   }
 
   void TaskScheduler::destroy() {
     delete threadPool; threadPool = nullptr;
   }
 
+  /* the indices of preempted threads get reused, their thread structures stay alive as other threads may still steal from them */
   __dllexport ssize_t TaskScheduler::allocThreadIndex()
   {
-    size_t threadIndex = threadCounter++;
-    assert(threadIndex < threadLocal.size());
+    if (numFreeThreadIndices > 0)
+    {
+      Lock<SpinLock> lock(retiredMutex);
+      if (!freeThreadIndices.empty()) {
+        const size_t threadIndex = freeThreadIndices.back();
+        freeThreadIndices.pop_back();
+        numFreeThreadIndices--;
+        threadCounter++;
+        return threadIndex;
+      }
+    }
+
+    size_t threadIndex = threadIndexCounter;
+    do {
+      if (threadIndex >= threadLocal.size()) return -1;
+    } while (!threadIndexCounter.compare_exchange_weak(threadIndex,threadIndex+1));
+    threadCounter++;
     return threadIndex;
   }
 
+  __dllexport void TaskScheduler::reapRetiredThreads()
+  {
+    assert(threadCounter == 0);
+    Lock<SpinLock> lock(retiredMutex);
+    retiredThreads.clear();
+    freeThreadIndices.clear();
+    numFreeThreadIndices = 0;
+  }
+
   void TaskScheduler::join()
   {
     mutex.lock();
-    size_t threadIndex = allocThreadIndex();
+    ssize_t threadIndex = allocThreadIndex();
     condition.wait(mutex, [&] () { return hasRootTask.load(); });
     mutex.unlock();
+
+    /* wait for the build to finish if all thread indices are in use */
+    if (threadIndex < 0) {
+      while (anyTasksRunning) yield();
+      return;
+    }
     std::exception_ptr except = thread_loop(threadIndex);
     if (except != nullptr) std::rethrow_exception(except);
   }
 
+  void TaskScheduler::cancel(std::exception_ptr except)
+  {
+    Lock<MutexSys> lock(mutex);
+    if (cancellingException == nullptr)
+      cancellingException = except;
+  }
+
   void TaskScheduler::reset() {
     hasRootTask = false;
   }
@@ -329,7 +499,7 @@ namespace embree
     return thread->scheduler->cancellingException == nullptr;
   }
 
-  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex)
+  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex, bool preemptible)
   {
     /* allocate thread structure */
     std::unique_ptr<Thread> mthread(new Thread(threadIndex,this)); // too large for stack allocation
@@ -337,11 +507,12 @@ namespace embree
     threadLocal[threadIndex].store(&thread);
     Thread* oldThread = swapThread(&thread);
 
-    /* main thread loop */
-    while (anyTasksRunning)
+    /* main thread loop, preemption is only checked between tasks when the local task queue is empty */
+    auto active = [&] () { return anyTasksRunning > 0 && !(preemptible && (isPreempted() || threadPool->isLeaving())); };
+    while (active())
     {
       steal_loop(thread,
-                 [&] () { return anyTasksRunning > 0; },
+                 active,
                  [&] () {
                    anyTasksRunning++;
                    while (thread.tasks.execute_local_internal(thread,nullptr));
@@ -351,6 +522,18 @@ namespace embree
     threadLocal[threadIndex].store(nullptr);
     swapThread(oldThread);
 
+    /* preempted threads leave without waiting for the other threads */
+    if (anyTasksRunning > 0)
+    {
+      thread.scheduler = null;
+      Lock<SpinLock> lock(retiredMutex);
+      retiredThreads.push_back(std::move(mthread));
+      freeThreadIndices.push_back(threadIndex);
+      numFreeThreadIndices++;
+      threadCounter--;
+      return nullptr;
+    }
+
     /* remember exception to throw */
     std::exception_ptr except = nullptr;
     if (cancellingException != nullptr) except = cancellingException;
@@ -378,7 +561,7 @@ namespace embree
   bool TaskScheduler::steal_from_other_threads(Thread& thread)
   {
     const size_t threadIndex = thread.threadIndex;
-    const size_t threadCount = this->threadCounter;
+    const size_t threadCount = this->threadIndexCounter;
 
     for (size_t i=1; i<threadCount; i++)
     {
@@ -401,6 +584,14 @@ namespace embree
     threadPool->startThreads();
   }
 
+  __dllexport void TaskScheduler::joinThreadPool(JoinedThreads& joined) {
+    threadPool->join(joined);
+  }
+
+  __dllexport void TaskScheduler::leaveThreadPool(JoinedThreads& joined) {
+    threadPool->leave(joined);
+  }
+
   __dllexport void TaskScheduler::addScheduler(const Ref<TaskScheduler>& scheduler) {
     threadPool->add(scheduler);
   }
@@ -35,8 +35,9 @@ namespace embree
     ALIGNED_STRUCT;
     friend class Device;
 
-    static const size_t TASK_STACK_SIZE = 2*1024;           //!< task structure stack
-    static const size_t CLOSURE_STACK_SIZE = 256*1024;    //!< stack for task closures
+    static const size_t TASK_STACK_SIZE = 2*1024;           //!< first segment of task structure stack, further segments double in size
+    static const size_t CLOSURE_STACK_SIZE = 256*1024;    //!< first segment of stack for task closures, further segments double in size
+    static const size_t MAX_STACK_SEGMENTS = 32;          //!< maximal number of task and closure stack segments
 
     struct Thread;
 
@@ -121,30 +122,65 @@ namespace embree
       size_t N;                          //!< approximative size of task
     };
 
+    /*! Task and closure stacks grow in segments of doubling size. Segments never move
+     *  and stay allocated until the queue gets destroyed, thus other threads can steal
+     *  from the left while the owning thread pushes new tasks to the right. */
     struct TaskQueue
     {
-      TaskQueue ()
-      : left(0), right(0), stackPtr(0) {}
+      __dllexport TaskQueue ();
+      __dllexport ~TaskQueue ();
+
+      /*! returns the segment that stores the element with the specified index */
+      static __forceinline size_t segmentOf(size_t index, size_t segmentSize) {
+        return __bsr(index/segmentSize+1);
+      }
+
+      /*! returns the index of the first element of the specified segment */
+      static __forceinline size_t segmentBegin(size_t segment, size_t segmentSize) {
+        return segmentSize*((size_t(1) << segment)-1);
+      }
+
+      /*! returns the task at the specified stack location */
+      __forceinline Task& task(size_t index)
+      {
+        const size_t k = segmentOf(index,TASK_STACK_SIZE);
+        return taskSegments[k].load()[index-segmentBegin(k,TASK_STACK_SIZE)];
+      }
 
       __forceinline void* alloc(size_t bytes, size_t align = 64)
       {
-        size_t ofs = bytes + ((align - stackPtr) & (align-1));
-        if (stackPtr + ofs > CLOSURE_STACK_SIZE)
-          throw std::runtime_error("closure stack overflow");
-        stackPtr += ofs;
-        return &stack[stackPtr-bytes];
+        size_t ofs = stackPtr + ((align - stackPtr) & (align-1));
+        size_t k = segmentOf(ofs,CLOSURE_STACK_SIZE);
+
+        /* closures never cross segment borders */
+        while (unlikely(ofs + bytes > segmentBegin(k+1,CLOSURE_STACK_SIZE)))
+          ofs = segmentBegin(++k,CLOSURE_STACK_SIZE);
+
+        if (unlikely(k >= MAX_STACK_SEGMENTS || closureSegments[k] == nullptr))
+          allocClosureSegment(k);
+        
+        stackPtr = ofs + bytes;
+        return &closureSegments[k][ofs-segmentBegin(k,CLOSURE_STACK_SIZE)];
+      }
+
+      /*! makes the task stack large enough to store a task at the specified location */
+      __forceinline void reserve(size_t index)
+      {
+        const size_t k = segmentOf(index,TASK_STACK_SIZE);
+        if (unlikely(k >= MAX_STACK_SEGMENTS || taskSegments[k].load() == nullptr))
+          allocTaskSegment(k);
       }
 
       template<typename Closure>
       __forceinline void push_right(Thread& thread, const size_t size, const Closure& closure)
       {
-        if (right >= TASK_STACK_SIZE)
-          throw std::runtime_error("task stack overflow");
+        reserve(right);
 
 	/* allocate new task on right side of stack */
         size_t oldStackPtr = stackPtr;
         TaskFunction* func = new (alloc(sizeof(ClosureTaskFunction<Closure>))) ClosureTaskFunction<Closure>(closure);
-        new (&tasks[right++]) Task(func,thread.task,oldStackPtr,size);
+        new (&task(right)) Task(func,thread.task,oldStackPtr,size);
+        right++;
 
 	/* also move left pointer */
 	if (left >= right-1) left = right-1;
@@ -157,15 +193,21 @@ namespace embree
 
       bool empty() { return right == 0; }
 
+    private:
+      __dllexport void allocTaskSegment(size_t segment);
+      __dllexport void allocClosureSegment(size_t segment);
+
     public:
 
       /* task stack */
-      Task tasks[TASK_STACK_SIZE];
+      Task tasks[TASK_STACK_SIZE];                             //!< first task segment
+      std::atomic<Task*> taskSegments[MAX_STACK_SEGMENTS];     //!< stealing threads read these concurrently
       __aligned(64) std::atomic<size_t> left;   //!< threads steal from left
       __aligned(64) std::atomic<size_t> right;  //!< new tasks are added to the right
 
       /* closure stack */
-      __aligned(64) char stack[CLOSURE_STACK_SIZE];
+      __aligned(64) char stack[CLOSURE_STACK_SIZE];           //!< first closure segment
+      char* closureSegments[MAX_STACK_SEGMENTS];
       size_t stackPtr;
     };
 
@@ -187,6 +229,16 @@ namespace embree
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
     };
 
+    /*! application threads that joined the thread pool through the same device */
+    struct JoinedThreads
+    {
+      JoinedThreads ()
+      : numThreads(0), leaving(false) {}
+
+      std::atomic<size_t> numThreads;  //!< number of currently joined threads
+      std::atomic<bool> leaving;       //!< set by leave, threads that join afterwards return immediately
+    };
+
     /*! pool of worker threads */
     struct ThreadPool
     {
@@ -196,8 +248,8 @@ namespace embree
       /*! starts the threads */
       __dllexport void startThreads();
 
-      /*! sets number of threads to use */
-      void setNumThreads(size_t numThreads, bool startThreads = false);
+      /*! sets number of threads to use, numUserThreads of them are application threads that join the pool */
+      void setNumThreads(size_t numThreads, size_t numUserThreads, bool startThreads = false);
 
       /*! adds a task scheduler object for scheduling */
       __dllexport void add(const Ref<TaskScheduler>& scheduler);
@@ -211,9 +263,31 @@ namespace embree
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
 
+      /*! lets an application thread work for all schedulers of the pool until leave gets called for the same joined threads */
+      __dllexport void join(JoinedThreads& joined);
+
+      /*! lets all application threads return that joined through the joined threads */
+      __dllexport void leave(JoinedThreads& joined);
+
+      /*! tests if the calling thread is an application thread that got asked to leave */
+      bool isLeaving() const;
+
+    private:
+      /*! returns the scheduler of highest priority that accepts another thread */
+      Ref<TaskScheduler> select();
+
+      /*! updates the priority that preempts worker threads */
+      void updatePriority();
+
+    public:
+      std::atomic<int> topPriority;  //!< highest priority of all schedulers that accept another thread
+
     private:
       std::atomic<size_t> numThreads;
+      std::atomic<size_t> numUserThreads;    //!< number of threads the application lends to the pool
       std::atomic<size_t> numThreadsRunning;
+      std::atomic<size_t> numJoinedThreads;  //!< number of currently joined application threads of all devices
+      std::atomic<bool> terminating;         //!< lets all joined application threads return when the pool gets destroyed
       bool set_affinity;
       std::atomic<bool> running;
       std::vector<thread_t> threads;
@@ -221,14 +295,14 @@ namespace embree
     private:
       MutexSys mutex;
       ConditionSys condition;
-      std::list<Ref<TaskScheduler> > schedulers;
+      std::list<Ref<TaskScheduler> > schedulers; //!< sorted by decreasing priority
     };
 
-    TaskScheduler ();
-    ~TaskScheduler ();
+    __dllexport TaskScheduler ();
+    __dllexport ~TaskScheduler ();
 
     /*! initializes the task scheduler */
-    static void create(size_t numThreads, bool set_affinity, bool start_threads);
+    static void create(size_t numThreads, size_t numUserThreads, bool set_affinity, bool start_threads);
 
     /*! destroys the task scheduler again */
     static void destroy();
@@ -237,14 +311,40 @@ namespace embree
     void join();
     void reset();
 
-    /*! let a worker thread allocate a thread index */
+    /*! sets the priority, worker threads leave schedulers of lower priority at task boundaries */
+    void setPriority(int priority) {
+      this->priority = priority;
+    }
+
+    /*! sets the maximal number of threads that work for this scheduler, 0 means unlimited */
+    void setMaxThreads(size_t maxThreads) {
+      this->maxThreads = maxThreads;
+    }
+
+    /*! cancels all tasks that did not start yet, spawn_root throws the specified exception */
+    void cancel(std::exception_ptr except);
+
+    /*! tests if another thread can join this scheduler */
+    __forceinline bool hasFreeThreadSlot() const {
+      return (maxThreads == 0 || threadCounter < maxThreads) && (threadIndexCounter < threadLocal.size() || numFreeThreadIndices > 0);
+    }
+
+    /*! tests if a scheduler of higher priority waits for threads */
+    __forceinline bool isPreempted() const {
+      return threadPool->topPriority > priority;
+    }
+
+    /*! let a worker thread allocate a thread index, returns -1 if all thread indices are in use */
     __dllexport ssize_t allocThreadIndex();
 
+    /*! frees the threads that left when preempted, only allowed when all threads left the scheduler */
+    __dllexport void reapRetiredThreads();
+
     /*! wait for some number of threads available (threadCount includes main thread) */
     void wait_for_threads(size_t threadCount);
 
-    /*! thread loop for all worker threads */
-    std::exception_ptr thread_loop(size_t threadIndex);
+    /*! thread loop for all worker threads, preemptible threads leave when preempted */
+    std::exception_ptr thread_loop(size_t threadIndex, bool preemptible = false);
 
     /*! steals a task from a different thread */
     bool steal_from_other_threads(Thread& thread);
@@ -259,6 +359,7 @@ namespace embree
       if (useThreadPool) startThreads();
 
       size_t threadIndex = allocThreadIndex();
+      assert(ssize_t(threadIndex) >= 0);
       std::unique_ptr<Thread> mthread(new Thread(threadIndex,this)); // too large for stack allocation
       Thread& thread = *mthread;
       assert(threadLocal[threadIndex].load() == nullptr);
@@ -288,6 +389,8 @@ namespace embree
       /* wait for all threads to terminate */
       threadCounter--;
       while (threadCounter > 0) yield();
+      reapRetiredThreads();
+      threadIndexCounter = 0;
       cancellingException = nullptr;
 
       /* re-throw proper exception */
@@ -338,6 +441,12 @@ namespace embree
     /* returns the total number of threads */
     __dllexport static size_t threadCount();
 
+    /*! lets the calling application thread work for the thread pool until leaveThreadPool gets called for the same joined threads */
+    __dllexport static void joinThreadPool(JoinedThreads& joined);
+
+    /*! lets all application threads return that joined the thread pool through the joined threads */
+    __dllexport static void leaveThreadPool(JoinedThreads& joined);
+
   private:
 
     /* returns the thread local task list of this worker thread */
@@ -360,7 +469,14 @@ namespace embree
 
   private:
     std::vector<atomic<Thread*>> threadLocal;
+    std::vector<std::unique_ptr<Thread>> retiredThreads; //!< threads that left when preempted, other threads may still steal from them
+    std::vector<size_t> freeThreadIndices;               //!< indices of retired threads, joining threads reuse them
+    std::atomic<size_t> numFreeThreadIndices;
+    SpinLock retiredMutex;
     std::atomic<size_t> threadCounter;
+    std::atomic<size_t> threadIndexCounter;
+    int priority;
+    size_t maxThreads;
     std::atomic<size_t> anyTasksRunning;
     std::atomic<bool> hasRootTask;
     std::exception_ptr cancellingException;
@@ -41,8 +41,8 @@ namespace embree
 {
   struct TaskScheduler
   {
-    /*! initializes the task scheduler */
-    static void create(size_t numThreads, bool set_affinity, bool start_threads);
+    /*! initializes the task scheduler, numUserThreads is ignored as application threads share the thread pool anyway */
+    static void create(size_t numThreads, size_t numUserThreads, bool set_affinity, bool start_threads);
 
     /*! destroys the task scheduler again */
     static void destroy();
@@ -162,7 +162,10 @@ enum RTCFormat
   RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR = 0x9234,
   RTC_FORMAT_FLOAT4X2_COLUMN_MAJOR = 0x9242,
   RTC_FORMAT_FLOAT4X3_COLUMN_MAJOR = 0x9243,
-  RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR = 0x9244
+  RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR = 0x9244,
+
+  /* transformation decomposed into scale, rotation quaternion, and translation */
+  RTC_FORMAT_QUATERNION_DECOMPOSITION = 0x9300
 };
 
 /* Build quality levels */
@@ -174,6 +177,14 @@ enum RTCBuildQuality
   RTC_BUILD_QUALITY_REFIT  = 3,
 };
 
+/* Build priorities */
+enum RTCBuildPriority
+{
+  RTC_BUILD_PRIORITY_LOW    = 0,
+  RTC_BUILD_PRIORITY_MEDIUM = 1,
+  RTC_BUILD_PRIORITY_HIGH   = 2,
+};
+
 /* Axis-aligned bounding box representation */
 struct RTC_ALIGN(16) RTCBounds
 {
@@ -191,9 +202,11 @@ struct RTC_ALIGN(16) RTCLinearBounds
 /* Intersection context flags */
 enum RTCIntersectContextFlags
 {
-  RTC_INTERSECT_CONTEXT_FLAG_NONE       = 0,
-  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT = (0 << 0), // optimize for incoherent rays
-  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0)  // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_NONE             = 0,
+  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT       = (0 << 0), // optimize for incoherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_COHERENT         = (1 << 0), // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_REDUCED_HIT      = (1 << 1), // ray streams skip storing Ng, u, v and instID of hits
+  RTC_INTERSECT_CONTEXT_FLAG_BACKFACE_CULLING = (1 << 2)  // cull back faces of triangle and quad meshes
 };
 
 /* Arguments for RTCFilterFunctionN */
@@ -210,12 +223,78 @@ struct RTCFilterFunctionNArguments
 /* Filter callback function */
 typedef void (*RTCFilterFunctionN)(const struct RTCFilterFunctionNArguments* args);
 
+/* Hit recorded in hit collection mode */
+struct RTCCollectedHit
+{
+  float t;             // distance of the hit
+  float Ng_x;          // x coordinate of geometry normal
+  float Ng_y;          // y coordinate of geometry normal
+  float Ng_z;          // z coordinate of geometry normal
+  float u;             // barycentric u coordinate of hit
+  float v;             // barycentric v coordinate of hit
+  unsigned int primID; // primitive ID
+  unsigned int geomID; // geometry ID
+  unsigned int instID; // instance ID
+};
+
+/* Hits collected along a ray, sorted by distance */
+struct RTCHitCollection
+{
+  struct RTCCollectedHit* hits; // hit buffer provided by the application
+  unsigned int maxHitCount;     // capacity of the hit buffer
+  unsigned int hitCount;        // number of collected hits, has to get initialized to 0
+};
+
+/* Traversal statistics flags */
+enum RTCTraversalStatisticsFlags
+{
+  RTC_TRAVERSAL_STATISTICS_FLAG_NONE          = 0,
+  RTC_TRAVERSAL_STATISTICS_FLAG_PERF_COUNTERS = (1 << 0)  // samples hardware performance counters per ray query call (Linux only)
+};
+
+/* Traversal statistics of one query type */
+struct RTCTraversalCounters
+{
+  unsigned long long calls;          // number of ray query calls
+  unsigned long long rays;           // number of traced rays
+  unsigned long long nodeVisits;     // number of intersected inner nodes
+  unsigned long long leafVisits;     // number of visited leaf nodes
+  unsigned long long primitiveTests; // number of intersected primitive blocks
+  unsigned long long filterCalls;    // number of invoked filter functions
+  unsigned long long maxStackDepth;  // maximal traversal stack depth
+  unsigned long long cycles;         // CPU cycles spent in ray query calls, requires performance counters
+  unsigned long long llcMisses;      // last level cache misses of ray query calls, requires performance counters
+};
+
+/* Traversal statistics gathered through an intersection context */
+struct RTCTraversalStatistics
+{
+  enum RTCTraversalStatisticsFlags flags; // statistics flags
+  struct RTCTraversalCounters intersect;     // statistics of intersect calls
+  struct RTCTraversalCounters occluded;      // statistics of occluded calls
+};
+
+/* Initializes traversal statistics. */
+RTC_FORCEINLINE void rtcInitTraversalStatistics(struct RTCTraversalStatistics* statistics, enum RTCTraversalStatisticsFlags flags)
+{
+  struct RTCTraversalCounters zero = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+  statistics->flags = flags;
+  statistics->intersect = zero;
+  statistics->occluded = zero;
+}
+
 /* Intersection context passed to intersect/occluded calls */
 struct RTCIntersectContext
 {
   enum RTCIntersectContextFlags flags;               // intersection flags
   RTCFilterFunctionN filter;                         // filter function to execute
   unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // will be set to geomID of instance when instance is entered
+  struct RTCHitCollection* hitCollections;           // enables hit collection mode, hit collections are indexed by the ray ID
+  float lodConeWidth;                                // width of the ray footprint at the ray origin
+  float lodConeAngle;                                // growth of the ray footprint per unit distance, level of detail selection is disabled when width and angle are 0
+  const double* rayOrigins;                          // optional double precision ray origins (x,y,z per ray) indexed by the ray ID, used to re-base rays into instances
+  const unsigned int* geometryVisibility;            // optional bitset indexed by geometry ID, geometries whose bit is cleared are culled
+  struct RTCTraversalStatistics* statistics;         // optional traversal statistics, counters get accumulated by all calls using this context
 };
 
 /* Initializes an intersection context. */
@@ -224,6 +303,12 @@ RTC_FORCEINLINE void rtcInitIntersectContext(struct RTCIntersectContext* context
   context->flags = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
   context->filter = NULL;
   context->instID[0] = -1;
+  context->hitCollections = NULL;
+  context->lodConeWidth = 0.0f;
+  context->lodConeAngle = 0.0f;
+  context->rayOrigins = NULL;
+  context->geometryVisibility = NULL;
+  context->statistics = NULL;
 }
   
 #if defined(__cplusplus)
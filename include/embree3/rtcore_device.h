@@ -59,7 +59,12 @@ enum RTCDeviceProperty
   RTC_DEVICE_PROPERTY_USER_GEOMETRY_SUPPORTED        = 100,
 
   RTC_DEVICE_PROPERTY_TASKING_SYSTEM        = 128,
-  RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129
+  RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129,
+  RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT   = 130,
+
+  RTC_DEVICE_PROPERTY_BUILD_ARENA_SIZE         = 160,
+  RTC_DEVICE_PROPERTY_BUILD_ARENA_CACHED_BYTES = 161,
+  RTC_DEVICE_PROPERTY_HUGEPAGE_ADVISED_BYTES   = 162
 };
 
 /* Gets a device property. */
@@ -92,6 +97,27 @@ typedef bool (*RTCMemoryMonitorFunction)(void* ptr, ssize_t bytes, bool post);
 /* Sets the memory monitor callback function. */
 RTC_API void rtcSetDeviceMemoryMonitorFunction(RTCDevice device, RTCMemoryMonitorFunction memoryMonitor, void* userPtr);
 
+/* Allocation flags */
+enum RTCAllocationFlags
+{
+  RTC_ALLOCATION_FLAG_NONE       = 0,
+  RTC_ALLOCATION_FLAG_HUGE_PAGES = (1 << 0)
+};
+
+/* Allocator callback functions */
+typedef void* (*RTCAllocFunction)(void* userPtr, size_t bytes, size_t alignment, enum RTCAllocationFlags flags);
+typedef void (*RTCFreeFunction)(void* userPtr, void* ptr, size_t bytes);
+typedef size_t (*RTCShrinkFunction)(void* userPtr, void* ptr, size_t bytesNew, size_t bytesOld);
+
+/* Sets the allocator for acceleration structure, build, and tessellation cache memory. */
+RTC_API void rtcSetDeviceAllocator(RTCDevice device, RTCAllocFunction alloc, RTCFreeFunction free, RTCShrinkFunction shrink, void* userPtr);
+
+/* Lends the calling thread to the thread pool of the device to work on any builds until rtcLeaveDeviceThreadPool gets called. */
+RTC_API void rtcJoinDeviceThreadPool(RTCDevice device);
+
+/* Lets all threads that joined the thread pool through the device return, threads that join through the device afterwards return immediately. */
+RTC_API void rtcLeaveDeviceThreadPool(RTCDevice device);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -147,12 +147,21 @@ RTC_API void rtcDisableGeometry(RTCGeometry geometry);
 /* Sets the number of time steps of the geometry. */
 RTC_API void rtcSetGeometryTimeStepCount(RTCGeometry geometry, unsigned int timeStepCount);
 
+/* Sets the time range covered by the uniformly spaced time steps of the geometry. */
+RTC_API void rtcSetGeometryTimeRange(RTCGeometry geometry, float startTime, float endTime);
+
+/* Sets the time of each time step of the geometry, NULL restores uniform time steps over [0,1]. */
+RTC_API void rtcSetGeometryTimeSteps(RTCGeometry geometry, const float* times);
+
 /* Sets the number of vertex attributes of the geometry. */
 RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry geometry, unsigned int vertexAttributeCount);
 
 /* Sets the ray mask of the geometry. */
 RTC_API void rtcSetGeometryMask(RTCGeometry geometry, unsigned int mask);
 
+/* Enables or disables backface culling for a triangle or quad mesh. */
+RTC_API void rtcSetGeometryBackfaceCulling(RTCGeometry geometry, bool enable);
+
 /* Sets the build quality of the geometry. */
 RTC_API void rtcSetGeometryBuildQuality(RTCGeometry geometry, enum RTCBuildQuality quality);
 
@@ -208,9 +217,27 @@ RTC_API void rtcFilterOcclusion(const struct RTCOccludedFunctionNArguments* args
 /* Sets the instanced scene of an instance geometry. */
 RTC_API void rtcSetGeometryInstancedScene(RTCGeometry geometry, RTCScene scene);
 
+/* Transformation of an instance specified as scale, followed by a
+   rotation (unit quaternion r + i*x + j*y + k*z), followed by a
+   translation. Multi-segment motion blur interpolates the rotation
+   spherically (slerp), scale and translation linearly. The slerp
+   follows the signs of the quaternions of consecutive time steps:
+   with a non-negative dot product it takes the shorter arc of less
+   than 180 degrees, negating a quaternion selects the longer arc of
+   up to 360 degrees. Opposite quaternions (a full turn) are invalid. */
+struct RTCQuaternionDecomposition
+{
+  float scale_x, scale_y, scale_z;
+  float quaternion_r, quaternion_i, quaternion_j, quaternion_k;
+  float translation_x, translation_y, translation_z;
+};
+
 /* Sets the transformation of an instance for the specified time step. */
 RTC_API void rtcSetGeometryTransform(RTCGeometry geometry, unsigned int timeStep, enum RTCFormat format, const void* xfm);
 
+/* Sets the double precision origin the transformation of an instance is relative to. */
+RTC_API void rtcSetGeometryTransformOrigin(RTCGeometry geometry, double x, double y, double z);
+
 /* Returns the interpolated transformation of an instance for the specified time. */
 RTC_API void rtcGetGeometryTransform(RTCGeometry geometry, float time, enum RTCFormat format, void* xfm);
 
@@ -36,7 +36,9 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_DYNAMIC                 = (1 << 0),
   RTC_SCENE_FLAG_COMPACT                 = (1 << 1),
   RTC_SCENE_FLAG_ROBUST                  = (1 << 2),
-  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3)
+  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3),
+  RTC_SCENE_FLAG_WATERTIGHT              = (1 << 4),
+  RTC_SCENE_FLAG_DOUBLE_BUFFERED         = (1 << 5)
 };
 
 /* Creates a new scene. */
@@ -68,6 +70,30 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Cancels the commit of the scene that is in progress or was requested asynchronously. */
+RTC_API void rtcCancelCommitScene(RTCScene scene);
+
+/* Asynchronous scene commit handle */
+typedef struct RTCCommitTy* RTCCommit;
+
+/* Completion callback function of an asynchronous scene commit */
+typedef void (*RTCCommitCompletionFunction)(void* ptr, RTCScene scene, enum RTCError error);
+
+/* Commits the scene asynchronously and invokes the optional completion callback once the commit finished. */
+RTC_API RTCCommit rtcCommitSceneAsync(RTCScene scene, RTCCommitCompletionFunction completion, void* ptr);
+
+/* Returns true if the asynchronous commit finished. */
+RTC_API bool rtcIsCommitDone(RTCCommit commit);
+
+/* Waits for the asynchronous commit to finish and returns its error code. */
+RTC_API enum RTCError rtcWaitCommit(RTCCommit commit);
+
+/* Retains the asynchronous commit handle (increments the reference count). */
+RTC_API void rtcRetainCommit(RTCCommit commit);
+
+/* Releases the asynchronous commit handle (decrements the reference count). */
+RTC_API void rtcReleaseCommit(RTCCommit commit);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -78,9 +104,18 @@ RTC_API void rtcSetSceneProgressMonitorFunction(RTCScene scene, RTCProgressMonit
 /* Sets the build quality of the scene. */
 RTC_API void rtcSetSceneBuildQuality(RTCScene scene, enum RTCBuildQuality quality);
 
+/* Sets the build priority of the scene. */
+RTC_API void rtcSetSceneBuildPriority(RTCScene scene, enum RTCBuildPriority priority);
+
+/* Sets the maximal number of threads that build the scene, 0 uses all threads. */
+RTC_API void rtcSetSceneBuildThreadCount(RTCScene scene, unsigned int threadCount);
+
 /* Sets the scene flags. */
 RTC_API void rtcSetSceneFlags(RTCScene scene, enum RTCSceneFlags flags);
 
+/* Sets the time range motion blur acceleration structures of the scene get build for. */
+RTC_API void rtcSetSceneTimeRange(RTCScene scene, float startTime, float endTime);
+
 /* Returns the scene flags. */
 RTC_API enum RTCSceneFlags rtcGetSceneFlags(RTCScene scene);
 
@@ -138,6 +173,45 @@ RTC_API void rtcOccludedNM(RTCScene scene, struct RTCIntersectContext* context,
 /* Tests a stream of M ray packets of size N in SOA format for occlusion with the scene. */
 RTC_API void rtcOccludedNp(RTCScene scene, struct RTCIntersectContext* context, const struct RTCRayNp* ray, unsigned int N);
 
+/* Point query structure for closest point query */
+struct RTC_ALIGN(16) RTCPointQuery
+{
+  float x;      // x coordinate of the query point
+  float y;      // y coordinate of the query point
+  float z;      // z coordinate of the query point
+  float time;   // time of the point query
+  float radius; // radius of the point query, shrinks to the distance of the closest point found
+};
+
+/* Closest point found by a point query */
+struct RTC_ALIGN(16) RTCPointQueryResult
+{
+  float x;             // x coordinate of the closest point
+  float y;             // y coordinate of the closest point
+  float z;             // z coordinate of the closest point
+  float u;             // barycentric u coordinate of the closest point
+  float v;             // barycentric v coordinate of the closest point
+  unsigned int primID; // primitive ID
+  unsigned int geomID; // geometry ID
+};
+
+/* Arguments for RTCPointQueryFunction */
+struct RTCPointQueryFunctionArguments
+{
+  struct RTCPointQuery* query;        // point query, the radius has to get shrunk when a closer point is found
+  struct RTCPointQueryResult* result; // closest point found so far
+  void* userPtr;                      // user pointer passed to rtcPointQuery
+  void* geometryUserPtr;              // user pointer of the geometry
+  unsigned int geomID;                // ID of the user geometry or instance
+  unsigned int primID;                // ID of the user primitive
+};
+
+/* Point query callback function for user geometries and instances, returns true if a closer point got found. */
+typedef bool (*RTCPointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
+
+/* Finds the closest point of the scene inside the query radius and returns true if a point got found, the callback function is invoked for user geometries and instances. */
+RTC_API bool rtcPointQuery(RTCScene scene, struct RTCPointQuery* query, struct RTCPointQueryResult* result, RTCPointQueryFunction queryFunc, void* userPtr);
+
 #if defined(__cplusplus)
 
 /* Helper for easily combining scene flags */
@@ -127,7 +127,7 @@ namespace embree
           const Mesh* mesh = scene->get<Mesh>(geomID);
           const LBBox3fa lbounds = mesh->linearBounds(primID, time_range);
           const unsigned num_time_segments = mesh->numTimeSegments();
-          const range<int> tbounds = getTimeSegmentRange(time_range, (float)num_time_segments);
+          const range<int> tbounds = mesh->timeSegmentRange(time_range);
           return PrimRefMB (lbounds, tbounds.size(), num_time_segments, geomID, primID);
         }
 
@@ -139,7 +139,7 @@ namespace embree
           const Mesh* mesh = scene->get<Mesh>(geomID);
           const LBBox3fa lbounds = mesh->linearBounds(space, primID, time_range);
           const unsigned num_time_segments = mesh->numTimeSegments();
-          const range<int> tbounds = getTimeSegmentRange(time_range, (float)num_time_segments);
+          const range<int> tbounds = mesh->timeSegmentRange(time_range);
           return PrimRefMB (lbounds, tbounds.size(), num_time_segments, geomID, primID);
         }
 
@@ -151,6 +151,16 @@ namespace embree
         __noinline LBBox3fa linearBounds(const PrimRefMB& prim, const BBox1f time_range, const LinearSpace3fa& space) const {
           return scene->get<Mesh>(prim.geomID())->linearBounds(space, prim.primID(), time_range);
         }
+
+        /*! returns the time segments of the primitive overlapping the time range */
+        __forceinline range<int> timeSegmentRange(const PrimRefMB& prim, const BBox1f time_range) const {
+          return scene->get<Mesh>(prim.geomID())->timeSegmentRange(time_range);
+        }
+
+        /*! returns the time of the i'th time step of the primitive */
+        __forceinline float timeStep(const PrimRefMB& prim, int itime) const {
+          return scene->get<Mesh>(prim.geomID())->timeStep(itime);
+        }
       };
 
     struct BVHBuilderMSMBlur
@@ -314,12 +324,12 @@ namespace embree
               for (size_t i=set.object_range.begin(); i<set.object_range.end(); i++)
               {
                 const PrimRefMB& prim = (*set.prims)[i];
-                const range<int> itime_range = getTimeSegmentRange(set.time_range,(float)prim.totalTimeSegments());
+                const range<int> itime_range = recalculatePrimRef.timeSegmentRange(prim,set.time_range);
                 const int localTimeSegments = itime_range.size();
                 assert(localTimeSegments > 0);
                 if (localTimeSegments > 1) {
                   const int icenter = (itime_range.begin() + itime_range.end())/2;
-                  const float splitTime = float(icenter)/float(prim.totalTimeSegments());
+                  const float splitTime = recalculatePrimRef.timeStep(prim,icenter);
                   return Split(0.0f,(unsigned)Split::SPLIT_TEMPORAL,0,splitTime);
                 }
               }
@@ -526,6 +536,14 @@ namespace embree
             const SetMB set(pinfo,&prims);
             auto ret = recurse(BuildRecord(set,1),nullptr,true);
             _mm_mfence(); // to allow non-temporal stores during build
+
+            /* a tree build for part of the time range gets a root node that culls rays outside that range */
+            if (unlikely(set.time_range.lower != 0.0f || set.time_range.upper != 1.0f))
+            {
+              auto node = createNode(createAlloc(),true);
+              setNode(node,0,ret);
+              ret = NodeRecordMB4D(node,ret.lbounds,set.time_range);
+            }
             return ret;
           }
 
@@ -410,6 +410,14 @@ namespace embree
             BuildRecord record(SetMB(pinfo,&prims),1);
             auto root = recurse(record,nullptr,true);
             _mm_mfence(); // to allow non-temporal stores during build
+
+            /* a tree build for part of the time range gets a root node that culls rays outside that range */
+            if (unlikely(pinfo.time_range.lower != 0.0f || pinfo.time_range.upper != 1.0f))
+            {
+              const NodeRef node = createAlignedNodeMB(createAlloc(),true);
+              setAlignedNodeMB(node,0,root);
+              root = NodeRecordMB4D(node,root.lbounds,pinfo.time_range);
+            }
             return root;
           }
 
@@ -449,10 +449,11 @@ namespace embree
                                  PrimRef* prims,
                                  const size_t extSize,
                                  const PrimInfo& pinfo,
-                                 const Settings& settings)
+                                 const Settings& settings,
+                                 const bool budgetBySAH = false)
         {
           typedef HeuristicArraySpatialSAH<SplitPrimitiveFunc,PrimRef,NUM_OBJECT_BINS,NUM_SPATIAL_BINS> Heuristic;
-          Heuristic heuristic(splitPrimitive,prims,pinfo);
+          Heuristic heuristic(splitPrimitive,prims,pinfo,budgetBySAH);
 
           /* calculate total surface area */ // FIXME: this sum is not deterministic
           const float A = (float) parallel_reduce(size_t(0),pinfo.size(),0.0, [&] (const range<size_t>& r) -> double {
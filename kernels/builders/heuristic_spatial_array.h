@@ -33,6 +33,9 @@ namespace embree
 #define SPATIAL_ASPLIT_AREA_THRESHOLD 0.000005f
 #endif
 
+/* in budget mode a spatial split with 1/SPATIAL_ASPLIT_BUDGET_GAIN_SCALE relative SAH gain may consume the entire extended range */
+#define SPATIAL_ASPLIT_BUDGET_GAIN_SCALE 4.0f
+
     struct PrimInfoExtRange : public CentGeomBBox3fa, public extended_range<size_t>
     {
       __forceinline PrimInfoExtRange() {
@@ -138,18 +141,28 @@ namespace embree
         static const size_t CREATE_SPLITS_STEP_SIZE = 64;
 
         __forceinline HeuristicArraySpatialSAH ()
-          : prims0(nullptr) {}
+          : prims0(nullptr), budgetBySAH(false) {}
         
         /*! remember prim array */
-        __forceinline HeuristicArraySpatialSAH (const PrimitiveSplitterFactory& splitterFactory, PrimRef* prims0, const CentGeomBBox3fa& root_info)
-          : prims0(prims0), splitterFactory(splitterFactory), root_info(root_info) {}
+        __forceinline HeuristicArraySpatialSAH (const PrimitiveSplitterFactory& splitterFactory, PrimRef* prims0, const CentGeomBBox3fa& root_info, const bool budgetBySAH = false)
+          : prims0(prims0), splitterFactory(splitterFactory), root_info(root_info), budgetBySAH(budgetBySAH) {}
+
+        /*! maximal number of replications a spatial split can consume from the extended range */
+        __forceinline size_t maxReplications(const PrimInfoExtRange& set, const float object_split_sah, const float spatial_split_sah) const
+        {
+          if (!budgetBySAH) return set.ext_range_size();
+
+          /* spend a fraction of the subtree budget proportional to the relative SAH gain */
+          const float gain = min(1.0f,SPATIAL_ASPLIT_BUDGET_GAIN_SCALE*(1.0f-spatial_split_sah/object_split_sah));
+          return size_t(gain*float(set.ext_range_size()));
+        }
 
 
         /*! compute extended ranges */
-        __noinline void setExtentedRanges(const PrimInfoExtRange& set, PrimInfoExtRange& lset, PrimInfoExtRange& rset, const size_t lweight, const size_t rweight)
+        __noinline void setExtentedRanges(const PrimInfoExtRange& set, PrimInfoExtRange& lset, PrimInfoExtRange& rset, const float lweight, const float rweight)
         {
           assert(set.ext_range_size() > 0);
-          const float left_factor           = (float)lweight / (lweight + rweight);
+          const float left_factor           = lweight / (lweight + rweight);
           const size_t ext_range_size       = set.ext_range_size();
           const size_t left_ext_range_size  = min((size_t)(floorf(left_factor * ext_range_size)),ext_range_size);
           const size_t right_ext_range_size = ext_range_size - left_ext_range_size;
@@ -209,7 +222,7 @@ namespace embree
 
               /* valid spatial split, better SAH and number of splits do not exceed extended range */
               if (spatial_split_sah < SPATIAL_ASPLIT_SAH_THRESHOLD*object_split_sah &&
-                  spatial_split.left + spatial_split.right - set.size() <= set.ext_range_size())
+                  spatial_split.left + spatial_split.right - set.size() <= maxReplications(set,object_split_sah,spatial_split_sah))
               {          
                 return Split(spatial_split,spatial_split_sah);
               }
@@ -375,7 +388,11 @@ namespace embree
           /* if we have an extended range, set extended child ranges and move right split range */
           if (unlikely(set.has_ext_range())) 
           {
-            setExtentedRanges(set,lset,rset,ext_weights.first,ext_weights.second);
+            /* in budget mode the extended range is distributed by the SAH cost of the children */
+            const float lcost = budgetBySAH ? halfArea(lset.geomBounds)*float(ext_weights.first ) : float(ext_weights.first );
+            const float rcost = budgetBySAH ? halfArea(rset.geomBounds)*float(ext_weights.second) : float(ext_weights.second);
+            if (lcost+rcost > 0.0f) setExtentedRanges(set,lset,rset,lcost,rcost);
+            else                    setExtentedRanges(set,lset,rset,float(ext_weights.first),float(ext_weights.second));
             moveExtentedRange(set,lset,rset);
           }
         }
@@ -573,6 +590,7 @@ namespace embree
         PrimRef* const prims0;
         const PrimitiveSplitterFactory& splitterFactory;
         const CentGeomBBox3fa& root_info;
+        const bool budgetBySAH;
       };
   }
 }
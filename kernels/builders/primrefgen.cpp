@@ -210,7 +210,8 @@ namespace embree
       {
         LBBox3fa bounds = empty;
         if (!mesh->linearBounds(j,t0t1,bounds)) continue;
-        const PrimRefMB prim(bounds,mesh->numTimeSegments(),mesh->numTimeSegments(),mesh->geomID,unsigned(j));
+        const range<int> tbounds = mesh->timeSegmentRange(t0t1);
+        const PrimRefMB prim(bounds,tbounds.size(),mesh->numTimeSegments(),mesh->geomID,unsigned(j));
         pinfo.add_primref(prim);
         prims[k++] = prim;
       }
@@ -1412,8 +1412,10 @@ namespace embree
       }
     };
 
-    /*! shrink allocated memory */
-    void shrink() { // FIXME: remove
+    /*! shrink allocated memory, only done for allocators of the application that provide a shrink function
+     *  and for transparent huge pages allocated by Embree, whose unused 4KB pages get returned */
+    void shrink() {
+      if (device->shrink_function || (device->transparent_hugepages && !device->alloc_function)) alloc.shrink();
     }
 
     /*! post build cleanup */
@@ -0,0 +1,278 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "bvh.h"
+#include "../builders/primrefgen.h"
+#include "../builders/bvh_builder_morton.h"
+#include "../builders/bvh_builder_sah.h"
+#include "../../common/algorithms/parallel_sort.h"
+
+#include "../geometry/triangle.h"
+#include "../geometry/trianglev.h"
+#include "../geometry/trianglei.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    MAYBE_UNUSED static const size_t HLBVH_SINGLE_THREAD_THRESHOLD = 1024;
+
+    /*! Hierarchical LBVH builder. The primitives are sorted along a
+     *  morton curve and the sorted array is split at the topmost
+     *  differing morton code bits into treelets of at most
+     *  treeletSize primitives. Each treelet is built using the
+     *  morton builder, and the upper levels of the tree are then
+     *  built using the binned SAH builder over the treelet roots. The
+     *  builder either builds over all meshes of a scene or over a
+     *  single mesh of a two level BVH. */
+    template<int N, typename Mesh, typename Primitive>
+    struct BVHNBuilderHLBVH : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::NodeRecord NodeRecord;
+      typedef typename BVH::AlignedNode AlignedNode;
+      typedef BVHBuilderMorton::BuildPrim BuildPrim;
+
+      static const size_t MAX_LEAF_SIZE = 8; //!< maximum number of primitives of a leaf
+
+      /*! the treelets hang below the leaves of the SAH levels, thus both share the depth limit of the BVH */
+      static const size_t MAX_TREELET_DEPTH = BVH::maxBuildDepthLeaf;
+      static const size_t MAX_TOP_DEPTH = BVH::maxDepth-MAX_TREELET_DEPTH;
+
+      BVH* bvh;
+      Scene* scene;
+      Mesh* mesh;
+      mvector<PrimRef> prims;
+      mvector<BuildPrim> morton;
+      mvector<BuildPrim> morton_tmp;
+      mvector<PrimRef> treelets;
+      const size_t treeletSize;
+
+      BVHNBuilderHLBVH (BVH* bvh, Scene* scene, const size_t treeletSize)
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), morton(scene->device,0), morton_tmp(scene->device,0), treelets(scene->device,0),
+          treeletSize(max(treeletSize,Primitive::max_size())) {}
+
+      BVHNBuilderHLBVH (BVH* bvh, Mesh* mesh, const size_t treeletSize)
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), morton(bvh->device,0), morton_tmp(bvh->device,0), treelets(bvh->device,0),
+          treeletSize(max(treeletSize,Primitive::max_size())) {}
+
+      /*! recursively splits the morton code range into treelets */
+      template<typename MortonBuilder>
+      void createTreelets(MortonBuilder& builder, const range<unsigned>& current, std::vector<range<unsigned>>& ranges)
+      {
+        if (current.size() <= treeletSize) {
+          ranges.push_back(current);
+          return;
+        }
+
+        range<unsigned> left, right;
+        builder.split(current,left,right);
+        createTreelets(builder,left,ranges);
+        createTreelets(builder,right,ranges);
+      }
+
+      void build()
+      {
+        /* we reset the allocator when the mesh size changed */
+        if (mesh && mesh->numPrimitivesChanged) {
+          bvh->alloc.clear();
+        }
+
+	/* skip build for empty scene */
+        const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives<Mesh,false>();
+        if (numPrimitives == 0) {
+          bvh->clear();
+          prims.clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderHLBVH");
+
+        /* enable os_malloc for two level build */
+        if (mesh)
+          bvh->alloc.setOSallocation(true);
+
+        /* initialize allocator */
+        const size_t node_bytes = numPrimitives*sizeof(AlignedNode)/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+        const size_t singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,HLBVH_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+
+        /* create primref array */
+        prims.resize(numPrimitives);
+        const PrimInfo pinfo = mesh ?
+          createPrimRefArray<Mesh>      (mesh ,prims,bvh->scene->progressInterface) :
+          createPrimRefArray<Mesh,false>(scene,prims,bvh->scene->progressInterface);
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(pinfo.size() == 0))
+        {
+          bvh->clear();
+          prims.clear();
+          return;
+        }
+
+        /* calculate morton codes of primitive centroids */
+        const size_t numPrims = pinfo.size();
+        morton.resize(numPrims);
+        morton_tmp.resize(numPrims);
+        const BVHBuilderMorton::MortonCodeMapping mapping(pinfo.centBounds);
+        parallel_for(size_t(0), numPrims, size_t(1024), [&] (const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++) {
+              morton[i].index = unsigned(i);
+              morton[i].code  = mapping.code(prims[i].bounds());
+            }
+          });
+
+        /* sort morton codes */
+        radix_sort_u32(morton.data(),morton_tmp.data(),numPrims,singleThreadThreshold);
+        morton_tmp.clear();
+
+        /* leaf creation gathers the primrefs a leaf references in morton order */
+        auto createLeaf = [&] (const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc) -> NodeRecord
+        {
+          assert(current.size() <= min(Primitive::max_size(),MAX_LEAF_SIZE));
+          PrimRef local[MAX_LEAF_SIZE];
+          BBox3fa bounds = empty;
+          for (size_t i=0; i<current.size(); i++) {
+            local[i] = prims[morton[current.begin()+i].index];
+            bounds.extend(local[i].bounds());
+          }
+          Primitive* accel = (Primitive*) alloc.malloc1(sizeof(Primitive),BVH::byteAlignment);
+          size_t begin = 0;
+          accel->fill(local,begin,current.size(),bvh->scene);
+          return NodeRecord(BVH::encodeLeaf((char*)accel,1),bounds);
+        };
+
+        auto setBounds = [&] (NodeRef ref, const NodeRecord* children, size_t num) -> NodeRecord
+        {
+          AlignedNode* node = ref.alignedNode();
+          BBox3fa bounds = empty;
+          for (size_t i=0; i<num; i++) {
+            node->setRef(i,children[i].ref);
+            node->setBounds(i,children[i].bounds);
+            bounds.extend(children[i].bounds);
+          }
+          return NodeRecord(ref,bounds);
+        };
+
+        auto calculateBounds = [&] (const BuildPrim& p) -> const BBox3fa {
+          return prims[p.index].bounds();
+        };
+
+        auto progress = [&] (size_t dn) { bvh->scene->progressMonitor(double(dn)); };
+
+        typename BVH::CreateAlloc createAlloc(bvh);
+        typename AlignedNode::Create createNode;
+        BVHBuilderMorton::Settings mortonSettings(N,MAX_TREELET_DEPTH,Primitive::max_size(),Primitive::max_size(),singleThreadThreshold);
+
+        BVHBuilderMorton::BuilderT<NodeRecord,FastAllocator::CachedAllocator,
+                                   decltype(createAlloc),decltype(createNode),decltype(setBounds),
+                                   decltype(createLeaf),decltype(calculateBounds),decltype(progress)>
+          mortonBuilder(createAlloc,createNode,setBounds,createLeaf,calculateBounds,progress,mortonSettings);
+        mortonBuilder.morton = morton.data();
+
+        /* split morton curve into treelets */
+        std::vector<range<unsigned>> ranges;
+        createTreelets(mortonBuilder,range<unsigned>(0,unsigned(numPrims)),ranges);
+
+        /* build all treelets in parallel */
+        treelets.resize(ranges.size());
+        parallel_for(size_t(0), ranges.size(), [&] (const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++) {
+              const NodeRecord treelet = mortonBuilder.recurse(1,ranges[i],nullptr,true);
+              treelets[i] = PrimRef(treelet.bounds,(size_t)treelet.ref);
+              _mm_mfence(); // to allow non-temporal stores during build
+            }
+          });
+
+        /* fast path for a single treelet */
+        if (treelets.size() == 1) {
+          bvh->set((NodeRef)treelets[0].ID(),LBBox3fa(pinfo.geomBounds),numPrims);
+        }
+
+        /* build SAH hierarchy over treelet roots */
+        else
+        {
+          PrimInfo tinfo(empty);
+          for (size_t i=0; i<treelets.size(); i++)
+            tinfo.add_center2(treelets[i]);
+
+          GeneralBVHBuilder::Settings settings;
+          settings.branchingFactor = N;
+          settings.maxDepth = MAX_TOP_DEPTH;
+          settings.logBlockSize = 0;
+          settings.minLeafSize = 1;
+          settings.maxLeafSize = 1;
+          settings.travCost = 1.0f;
+          settings.intCost = 1.0f;
+          settings.singleThreadThreshold = singleThreadThreshold;
+
+          NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>(
+            createAlloc,
+            typename AlignedNode::Create2(),
+            typename AlignedNode::Set2(),
+            [&] (const PrimRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef {
+              assert(range.size() == 1);
+              return (NodeRef) refs[range.begin()].ID();
+            },
+            [&] (size_t dn) {},
+            treelets.data(),tinfo,settings);
+
+          bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrims);
+        }
+        bvh->layoutLargeNodes(size_t(numPrims*0.005f));
+
+        /* clear temporary data for static geometry */
+        treelets.clear();
+        if (bvh->scene->isStaticAccel()) {
+          prims.clear();
+          morton.clear();
+          bvh->shrink();
+        }
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+        morton.clear();
+        morton_tmp.clear();
+        treelets.clear();
+      }
+    };
+
+#if defined(EMBREE_GEOMETRY_TRIANGLES)
+    Builder* BVH4Triangle4SceneBuilderHLBVH  (void* bvh, Scene* scene, size_t treeletSize) { return new BVHNBuilderHLBVH<4,TriangleMesh,Triangle4> ((BVH4*)bvh,scene,treeletSize); }
+    Builder* BVH4Triangle4vSceneBuilderHLBVH (void* bvh, Scene* scene, size_t treeletSize) { return new BVHNBuilderHLBVH<4,TriangleMesh,Triangle4v>((BVH4*)bvh,scene,treeletSize); }
+    Builder* BVH4Triangle4iSceneBuilderHLBVH (void* bvh, Scene* scene, size_t treeletSize) { return new BVHNBuilderHLBVH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,treeletSize); }
+
+    Builder* BVH4Triangle4MeshBuilderHLBVH  (void* bvh, TriangleMesh* mesh, size_t treeletSize) { return new BVHNBuilderHLBVH<4,TriangleMesh,Triangle4> ((BVH4*)bvh,mesh,treeletSize); }
+    Builder* BVH4Triangle4vMeshBuilderHLBVH (void* bvh, TriangleMesh* mesh, size_t treeletSize) { return new BVHNBuilderHLBVH<4,TriangleMesh,Triangle4v>((BVH4*)bvh,mesh,treeletSize); }
+    Builder* BVH4Triangle4iMeshBuilderHLBVH (void* bvh, TriangleMesh* mesh, size_t treeletSize) { return new BVHNBuilderHLBVH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,mesh,treeletSize); }
+#if defined(__AVX__)
+    Builder* BVH8Triangle4SceneBuilderHLBVH  (void* bvh, Scene* scene, size_t treeletSize) { return new BVHNBuilderHLBVH<8,TriangleMesh,Triangle4> ((BVH8*)bvh,scene,treeletSize); }
+    Builder* BVH8Triangle4vSceneBuilderHLBVH (void* bvh, Scene* scene, size_t treeletSize) { return new BVHNBuilderHLBVH<8,TriangleMesh,Triangle4v>((BVH8*)bvh,scene,treeletSize); }
+    Builder* BVH8Triangle4iSceneBuilderHLBVH (void* bvh, Scene* scene, size_t treeletSize) { return new BVHNBuilderHLBVH<8,TriangleMesh,Triangle4i>((BVH8*)bvh,scene,treeletSize); }
+
+    Builder* BVH8Triangle4MeshBuilderHLBVH  (void* bvh, TriangleMesh* mesh, size_t treeletSize) { return new BVHNBuilderHLBVH<8,TriangleMesh,Triangle4> ((BVH8*)bvh,mesh,treeletSize); }
+    Builder* BVH8Triangle4vMeshBuilderHLBVH (void* bvh, TriangleMesh* mesh, size_t treeletSize) { return new BVHNBuilderHLBVH<8,TriangleMesh,Triangle4v>((BVH8*)bvh,mesh,treeletSize); }
+    Builder* BVH8Triangle4iMeshBuilderHLBVH (void* bvh, TriangleMesh* mesh, size_t treeletSize) { return new BVHNBuilderHLBVH<8,TriangleMesh,Triangle4i>((BVH8*)bvh,mesh,treeletSize); }
+#endif
+#endif
+  }
+}
@@ -424,7 +424,7 @@ namespace embree
         const size_t numTimeSteps = scene->getNumTimeSteps<Mesh,true>();
         const size_t numTimeSegments = numTimeSteps-1; assert(numTimeSteps > 1);
 
-        if (numTimeSegments == 1)
+        if (numTimeSegments == 1 && !scene->hasPartialTimeRange() && scene->hasDefaultTimeSteps<Mesh,true>())
           buildSingleSegment(numPrimitives);
         else
           buildMultiSegment(numPrimitives);
@@ -474,7 +474,7 @@ namespace embree
       {
         /* create primref array */
         mvector<PrimRefMB> prims(scene->device,numPrimitives);
-        PrimInfoMB pinfo = createPrimRefArrayMSMBlur<Mesh>(scene,prims,bvh->scene->progressInterface);
+        PrimInfoMB pinfo = createPrimRefArrayMSMBlur<Mesh>(scene,prims,bvh->scene->progressInterface,scene->time_range);
 
         /* estimate acceleration structure size */
         const size_t node_bytes = pinfo.num_time_segments*sizeof(AlignedNodeMB)/(4*N);
@@ -527,17 +527,59 @@ namespace embree
       mvector<PrimRef> prims0;
       GeneralBVHBuilder::Settings settings;
       const float splitFactor;
+      const bool budget;
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims0(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(scene->device->max_spatial_split_replications), budget(scene->device->spatial_split_budget) {}
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(bvh->device->max_spatial_split_replications), budget(bvh->device->spatial_split_budget) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
+      /*! estimates the number of replications spatial splits will benefit from
+       *  and grows the primref array in chunks until it covers this estimate */
+      size_t growPrimRefArray(const PrimInfo& pinfo, const size_t maxSplitPrimitives)
+      {
+        const size_t numPrimitives = pinfo.size();
+        const double A = parallel_reduce(size_t(0),numPrimitives,0.0, [&] (const range<size_t>& r) -> double {
+            double A = 0.0;
+            for (size_t i=r.begin(); i<r.end(); i++)
+              A += area(prims0[i].bounds());
+            return A;
+          },std::plus<double>());
+
+        /* primitives much larger than average get replicated about log2 of their relative size many times */
+        size_t demand = 0;
+        if (A > 0.0)
+        {
+          const float invAvgArea = float(double(numPrimitives)/A);
+          demand = parallel_reduce(size_t(0),numPrimitives,size_t(0), [&] (const range<size_t>& r) -> size_t {
+              size_t n = 0;
+              for (size_t i=r.begin(); i<r.end(); i++) {
+                const float rel = area(prims0[i].bounds())*invAvgArea;
+                if (rel >= 2.0f) n += min(size_t(__bsr(size_t(min(rel,1E9f)))),size_t(8));
+              }
+              return n;
+            },std::plus<size_t>());
+        }
+
+        /* grow in chunks of 1/16th of the primitives up to the maximal replication factor */
+        const size_t chunkSize = max(size_t(1024),numPrimitives/16);
+        size_t numSplitPrimitives = numPrimitives+chunkSize;
+        while (numSplitPrimitives < numPrimitives+demand && numSplitPrimitives < maxSplitPrimitives)
+          numSplitPrimitives += chunkSize;
+        numSplitPrimitives = max(numPrimitives,min(numSplitPrimitives,maxSplitPrimitives));
+
+        if (numSplitPrimitives > prims0.size()) {
+          prims0.reserve(numSplitPrimitives);
+          prims0.resize(numSplitPrimitives);
+        }
+        return numSplitPrimitives;
+      }
+
       void build()
       {
         /* we reset the allocator when the mesh size changed */
@@ -555,13 +597,20 @@ namespace embree
 
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderFastSpatialSAH");
 
-        /* create primref array */
-        const size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
-        prims0.resize(numSplitPrimitives);
+        /* create primref array, in budget mode it is grown later based on the estimated number of replications */
+        size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
+        if (budget) {
+          prims0.reserve(numOriginalPrimitives);
+          prims0.resize(numOriginalPrimitives);
+        } else
+          prims0.resize(numSplitPrimitives);
         PrimInfo pinfo = mesh ?
           createPrimRefArray<Mesh>  (mesh ,prims0,bvh->scene->progressInterface) :
           createPrimRefArray<Mesh,false>(scene,prims0,bvh->scene->progressInterface);
 
+        if (budget)
+          numSplitPrimitives = growPrimRefArray(pinfo,numSplitPrimitives);
+
         Splitter splitter(scene);
 
         /* enable os_malloc for two level build */
@@ -585,7 +634,7 @@ namespace embree
           bvh->scene->progressInterface,
           prims0.data(),
           numSplitPrimitives,
-          pinfo,settings);
+          pinfo,settings,budget);
 
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
@@ -125,9 +125,11 @@ namespace embree
           BVH*     object  = objects [objectID]; assert(object);
           Ref<Builder>& builder = builders[objectID].builder; assert(builder);
           
-          /* build object if it got modified */
-          if (mesh->isModified())
+          /* build object if it got modified or was not built yet */
+          if (mesh->isModified() || !builders[objectID].built) {
             builder->build();
+            builders[objectID].built = true;
+          }
 
           /* create build primitive */
           if (!object->getBounds().empty())
@@ -120,18 +120,20 @@ namespace embree
       struct BuilderState
       {
         BuilderState ()
-        : builder(nullptr), quality(RTC_BUILD_QUALITY_LOW) {}
+        : builder(nullptr), quality(RTC_BUILD_QUALITY_LOW), built(false) {}
 
         BuilderState (const Ref<Builder>& builder, RTCBuildQuality quality)
-        : builder(builder), quality(quality) {}
+        : builder(builder), quality(quality), built(false) {}
         
         void clear() {
           builder = nullptr;
           quality = RTC_BUILD_QUALITY_LOW;
+          built = false;
         }
         
         Ref<Builder> builder;
         RTCBuildQuality quality;
+        bool built;  //!< set once the object got built, objects of unmodified meshes get built when created
       };
       
     public:
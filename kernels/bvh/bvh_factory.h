@@ -28,6 +28,6 @@ namespace embree
   {
   public:
     enum class BuildVariant     { STATIC, DYNAMIC, HIGH_QUALITY };
-    enum class IntersectVariant { FAST, ROBUST };
+    enum class IntersectVariant { FAST, ROBUST, WATERTIGHT };
   };
 }
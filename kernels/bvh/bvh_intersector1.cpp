@@ -16,6 +16,7 @@
 
 #include "bvh_intersector1.h"
 #include "node_intersector1.h"
+#include "node_intersector_point_query.h"
 #include "bvh_traverser1.h"
 
 #include "../geometry/intersector_iterators.h"
@@ -35,6 +36,35 @@ namespace embree
 {
   namespace isa
   {
+    /*! returns the IDs of the first primitive of a leaf, leaves without
+     *  primitive IDs never get replaced by a level of detail proxy */
+    template<typename Primitive>
+    __forceinline bool getProxyIDs(const Primitive* prim, unsigned& geomID, unsigned& primID) {
+      geomID = prim->geomID(0); primID = prim->primID(0); return true;
+    }
+
+    __forceinline bool getProxyIDs(const Bezier1v* prim, unsigned& geomID, unsigned& primID) {
+      geomID = prim->geomID(); primID = prim->primID(); return true;
+    }
+
+    __forceinline bool getProxyIDs(const Bezier1i* prim, unsigned& geomID, unsigned& primID) {
+      geomID = prim->geomID(); primID = prim->primID(); return true;
+    }
+
+    __forceinline bool getProxyIDs(const Object* prim, unsigned& geomID, unsigned& primID) { return false; }
+    __forceinline bool getProxyIDs(const GridSOA* prim, unsigned& geomID, unsigned& primID) { return false; }
+    __forceinline bool getProxyIDs(const SubdivPatch1Cached* prim, unsigned& geomID, unsigned& primID) { return false; }
+
+    /*! proxy hits pass the same ray mask and visibility tests as hits of the primitive intersectors */
+    template<typename Ray>
+    __forceinline bool isProxyVisible(const Ray& ray, const IntersectContext* context, const unsigned geomID)
+    {
+#if defined(EMBREE_RAY_MASK)
+      if ((context->scene->get(geomID)->mask & ray.mask) == 0) return false;
+#endif
+      return context->isGeometryVisible(geomID);
+    }
+
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
     void BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::intersect(const Accel::Intersectors* __restrict__ This,
                                                                               RayHit& __restrict__ ray,
@@ -66,6 +96,8 @@ namespace embree
 
       /* initialize the node traverser */
       BVHNNodeTraverser1<N, Nx, robust, types> nodeTraverser(tray);
+      BVHNNodeTraverser1Lod<N, Nx> lod(context);
+      BVHNodeTraverser1Statistics stats(context,false);
 
       /* pop loop */
       while (true) pop:
@@ -93,11 +125,46 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          stats.node();
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
             goto pop;
 
+          /* replace children smaller than the ray footprint by proxy hits */
+          if (unlikely(lod.enabled()))
+          {
+            for (size_t proxies = lod.proxyMask(cur, mask, tNear); proxies != 0; )
+            {
+              const size_t i = __bscf(proxies);
+              size_t num; const Primitive* prim = (const Primitive*) lod.representative(cur.alignedNode()->child(i)).leaf(num);
+              unsigned geomID, primID;
+              if (num == 0 || !getProxyIDs(prim, geomID, primID)) continue;
+              if (!isProxyVisible(ray, context, geomID)) continue;
+              mask &= ~((size_t)1 << i);
+              if (tNear[i] >= ray.tfar) continue;
+
+              /* hit collection mode records the proxy hit and rejects it */
+              const Vec3fa Ng = lod.entryNormal(cur.alignedNode()->bounds(i), ray.org, ray.dir);
+              if (unlikely(context->hasHitCollection())) {
+                context->collectHit(ray.id, ray.tfar, tNear[i], Ng, 0.0f, 0.0f, primID, geomID, context->instID);
+                tray.tfar = ray.tfar;
+                continue;
+              }
+
+              ray.tfar = tNear[i];
+              ray.Ng = Ng;
+              ray.u = 0.0f;
+              ray.v = 0.0f;
+              ray.geomID = geomID;
+              ray.primID = primID;
+              ray.instID = context->instID;
+              tray.tfar = ray.tfar;
+            }
+            if (unlikely(mask == 0))
+              goto pop;
+          }
+
           /* select next child and push other children */
           nodeTraverser.traverseClosestHit(cur, mask, tNear, stackPtr, stackEnd);
         }
@@ -110,6 +177,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        stats.leaf(num,stackPtr-stack);
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(pre, ray, context, prim, num, lazy_node);
         tray.tfar = ray.tfar;
@@ -158,6 +226,8 @@ namespace embree
 
       /* initialize the node traverser */
       BVHNNodeTraverser1<N, Nx, robust, types> nodeTraverser(tray);
+      BVHNNodeTraverser1Lod<N, Nx> lod(context);
+      BVHNodeTraverser1Statistics stats(context,true);
 
       /* pop loop */
       while (true) pop:
@@ -175,11 +245,27 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          stats.node();
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
             goto pop;
 
+          /* any child smaller than the ray footprint occludes the ray, if its proxy is visible to the ray */
+          if (unlikely(lod.enabled()))
+          {
+            for (size_t proxies = lod.proxyMask(cur, mask, tNear); proxies != 0; )
+            {
+              const size_t i = __bscf(proxies);
+              size_t num; const Primitive* prim = (const Primitive*) lod.representative(cur.alignedNode()->child(i)).leaf(num);
+              unsigned geomID, primID;
+              if (num == 0 || !getProxyIDs(prim, geomID, primID)) continue;
+              if (!isProxyVisible(ray, context, geomID)) continue;
+              ray.tfar = neg_inf;
+              return;
+            }
+          }
+
           /* select next child and push other children */
           nodeTraverser.traverseAnyHit(cur, mask, tNear, stackPtr, stackEnd);
         }
@@ -192,6 +278,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        stats.leaf(num,stackPtr-stack);
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(pre, ray, context, prim, num, lazy_node)) {
           ray.tfar = neg_inf;
@@ -205,5 +292,74 @@ namespace embree
         }
       }
     }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    bool BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::pointQuery(const Accel::Intersectors* __restrict__ This,
+                                                                               PointQuery* __restrict__ query,
+                                                                               PointQueryContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+      if (bvh->root == BVH::emptyNode) return false;
+
+      /* stack state, stores squared distances to the query point */
+      StackItemT<NodeRef> stack[stackSize];    // stack of nodes
+      StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
+      StackItemT<NodeRef>* stackEnd = stack+stackSize;
+      stack[0].ptr  = bvh->root;
+      stack[0].dist = 0;
+
+      /* verify correct input */
+      assert(query->radius >= 0.0f);
+      assert(!(types & BVH_MB) || (query->time >= 0.0f && query->time <= 1.0f));
+
+      /* load the query into SIMD registers */
+      TravPointQuery<N> tquery(query->p(), query->radius);
+      bool changed = false;
+
+      /* pop loop */
+      while (true) pop:
+      {
+        /* pop next node */
+        if (unlikely(stackPtr == stack)) break;
+        stackPtr--;
+        NodeRef cur = NodeRef(stackPtr->ptr);
+
+        /* if popped node is too far, pop next one */
+        if (unlikely(*(float*)&stackPtr->dist > tquery.rad2[0]))
+          continue;
+
+        /* downtraversal loop */
+        while (true)
+        {
+          /* compute distances to child boxes */
+          size_t mask; vfloat<Nx> dist;
+          bool nodeTested = BVHNNodePointQuery1<N, Nx, types>::pointQuery(cur, tquery, query->time, dist, mask);
+          if (unlikely(!nodeTested)) break;
+
+          /* if no child overlaps the query sphere, pop next node */
+          if (unlikely(mask == 0))
+            goto pop;
+
+          /* select closest child and push other children */
+          BVHNNodeTraverser1Hit<N, Nx, types>::traverseClosestHit(cur, mask, dist, stackPtr, stackEnd);
+        }
+
+        /* instances are handled by the user callback */
+        if (unlikely(cur.isTransformNode(types)))
+        {
+          const TransformNode* node = cur.transformNode();
+          changed |= context->callback(query, nullptr, node->instID, 0);
+          tquery.setRadius(query->radius);
+          continue;
+        }
+
+        /* this is a leaf node */
+        assert(cur != BVH::emptyNode);
+        size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        changed |= PrimitiveIntersector1::pointQuery(query, context, prim, num);
+        tquery.setRadius(query->radius);
+      }
+      return changed;
+    }
   }
 }
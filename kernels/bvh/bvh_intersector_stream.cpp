@@ -163,7 +163,6 @@ namespace embree
       }
 
       BVH* __restrict__ bvh = (BVH*)This->ptr;
-      __aligned(64) StackItemMaskCoherent stack[stackSizeSingle];  // stack of nodes
       assert(numOctantRays <= MAX_INTERNAL_STREAM_SIZE);
 
       /* inactive rays should have been filtered out before */
@@ -171,20 +170,51 @@ namespace embree
       __aligned(64) Frustum<robust> frustum;
 
       bool commonOctant = true;
-      size_t m_active = initPacketsAndFrustum(inputPackets, numOctantRays, packets, frustum, commonOctant);
+      const size_t m_active = initPacketsAndFrustum(inputPackets, numOctantRays, packets, frustum, commonOctant);
 
       /* valid rays */
       if (unlikely(m_active == 0)) return;
 
-      /* case of non-common origin */
-      if (unlikely(!commonOctant))
-      {
-        const size_t numPackets = (numOctantRays+K-1)/K; 
-        for (size_t i = 0; i < numPackets; i++)
-          This->occluded(inputPackets[i]->tnear() <= inputPackets[i]->tfar, *inputPackets[i], context);
+      if (likely(commonOctant)) {
+        occludedCoherent(bvh, inputPackets, packets, m_active, frustum, context);
         return;
       }
 
+      /* shadow rays towards an area light do not share an octant, thus
+         we trace the rays of each octant with its own frustum */
+      const size_t numPackets = (numOctantRays+K-1)/K;
+      size_t m_octants[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+      for (size_t i = 0; i < numPackets; i++)
+      {
+        const size_t m_packet = ((size_t)1 << K)-1;
+        const size_t m_x = movemask(packets[i].rdir.x < 0.0f);
+        const size_t m_y = movemask(packets[i].rdir.y < 0.0f);
+        const size_t m_z = movemask(packets[i].rdir.z < 0.0f);
+        for (size_t octant = 0; octant < 8; octant++)
+        {
+          const size_t m_octant = ((octant & 1) ? m_x : ~m_x) & ((octant & 2) ? m_y : ~m_y) & ((octant & 4) ? m_z : ~m_z);
+          m_octants[octant] |= (m_octant & m_packet) << (i*K);
+        }
+      }
+
+      for (size_t octant = 0; octant < 8; octant++)
+      {
+        const size_t m_octant = m_octants[octant] & m_active;
+        if (m_octant == 0) continue;
+        initFrustum(m_octant, inputPackets, packets, frustum);
+        occludedCoherent(bvh, inputPackets, packets, m_octant, frustum, context);
+      }
+    }
+
+    template<int N, int Nx, int K, int types, bool robust, typename PrimitiveIntersector>
+    __forceinline void BVHNIntersectorStream<N, Nx, K, types, robust, PrimitiveIntersector>::occludedCoherent(BVH* __restrict__ bvh,
+                                                                                                              RayK<K>** inputPackets,
+                                                                                                              TravRayKStream<K, robust>* packets,
+                                                                                                              size_t m_active,
+                                                                                                              const Frustum<robust>& frustum,
+                                                                                                              IntersectContext* context)
+    {
+      __aligned(64) StackItemMaskCoherent stack[stackSizeSingle];  // stack of nodes
       stack[0].mask   = m_active;
       stack[0].parent = 0;
       stack[0].child  = bvh->root;
@@ -262,6 +292,9 @@ namespace embree
           m_active &= ~((size_t)movemask(m_hit) << (i*K));
         }
 
+        /* terminate traversal as soon as all rays are occluded */
+        if (unlikely(m_active == 0)) break;
+
       } // traversal + intersection
     }
 
@@ -114,6 +114,39 @@ namespace embree
         return m_active;
       }
 
+      /*! calculates the frustum of a subset of the rays of the stream */
+      __forceinline static void initFrustum(size_t m_active, RayK<K>** inputPackets, const TravRayKStream<K, robust>* packets, Frustum<robust>& frustum)
+      {
+        Vec3vf<K> tmp_min_rdir(pos_inf);
+        Vec3vf<K> tmp_max_rdir(neg_inf);
+        Vec3vf<K> tmp_min_org(pos_inf);
+        Vec3vf<K> tmp_max_org(neg_inf);
+        vfloat<K> tmp_min_dist(pos_inf);
+        vfloat<K> tmp_max_dist(neg_inf);
+
+        for (size_t bits = m_active; bits != 0; )
+        {
+          const size_t i = __bsf(bits) / K;
+          const size_t m_packet = (((size_t)1 << K)-1) << (i*K);
+          const vbool<K> m_valid((int)((bits & m_packet) >> (i*K)));
+          bits &= ~m_packet;
+
+          const Vec3vf<K>& org = inputPackets[i]->org;
+          tmp_min_dist = min(tmp_min_dist, select(m_valid, packets[i].tnear, vfloat<K>(pos_inf)));
+          tmp_max_dist = max(tmp_max_dist, select(m_valid, packets[i].tfar , vfloat<K>(neg_inf)));
+          tmp_min_rdir = min(tmp_min_rdir, select(m_valid, packets[i].rdir, Vec3vf<K>(pos_inf)));
+          tmp_max_rdir = max(tmp_max_rdir, select(m_valid, packets[i].rdir, Vec3vf<K>(neg_inf)));
+          tmp_min_org  = min(tmp_min_org , select(m_valid, org, Vec3vf<K>(pos_inf)));
+          tmp_max_org  = max(tmp_max_org , select(m_valid, org, Vec3vf<K>(neg_inf)));
+        }
+
+        frustum.init(Vec3fa(reduce_min(tmp_min_org.x), reduce_min(tmp_min_org.y), reduce_min(tmp_min_org.z)),
+                     Vec3fa(reduce_max(tmp_max_org.x), reduce_max(tmp_max_org.y), reduce_max(tmp_max_org.z)),
+                     Vec3fa(reduce_min(tmp_min_rdir.x), reduce_min(tmp_min_rdir.y), reduce_min(tmp_min_rdir.z)),
+                     Vec3fa(reduce_max(tmp_max_rdir.x), reduce_max(tmp_max_rdir.y), reduce_max(tmp_max_rdir.z)),
+                     reduce_min(tmp_min_dist), reduce_max(tmp_max_dist),
+                     N);
+      }
       
       __forceinline static size_t intersectAlignedNodePacket(size_t m_active,
                                                              const TravRayKStream<K,robust>* packets,
@@ -257,6 +290,8 @@ namespace embree
 
       static const size_t stackSizeSingle = 1+(N-1)*BVH::maxDepth;
 
+      static void occludedCoherent(BVH* bvh, RayK<K>** inputPackets, TravRayKStream<K, robust>* packets, size_t m_active, const Frustum<robust>& frustum, IntersectContext* context);
+
     public:
       static void intersect(Accel::Intersectors* This, RayHitK<K>** inputRays, size_t numRays, IntersectContext* context);
       static void occluded (Accel::Intersectors* This, RayK<K>** inputRays, size_t numRays, IntersectContext* context);
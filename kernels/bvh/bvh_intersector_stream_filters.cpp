@@ -23,6 +23,27 @@ namespace embree
   {
     MAYBE_UNUSED static const size_t MAX_INTERNAL_PACKET_STREAM_SIZE = MAX_INTERNAL_STREAM_SIZE / VSIZEX;
 
+    /* the reduced hit mode only skips stores of hit data, occlusion results are always written */
+    template<typename RayStreamT, typename Offset>
+    __forceinline void storeHitByOffset(RayStreamT& rayN, const vboolx& valid, const Offset& offset, const RayHitK<VSIZEX>& ray, IntersectContext* context) {
+      rayN.setHitByOffset(valid, offset, ray, isReducedHit(context->user->flags));
+    }
+
+    template<typename RayStreamT, typename Offset>
+    __forceinline void storeHitByOffset(RayStreamT& rayN, const vboolx& valid, const Offset& offset, const RayK<VSIZEX>& ray, IntersectContext* context) {
+      rayN.setHitByOffset(valid, offset, ray);
+    }
+
+    template<typename RayStreamT>
+    __forceinline void storeHitByIndex(RayStreamT& rayN, const vboolx& valid, const vintx& index, const RayHitK<VSIZEX>& ray, IntersectContext* context) {
+      rayN.setHitByIndex(valid, index, ray, isReducedHit(context->user->flags));
+    }
+
+    template<typename RayStreamT>
+    __forceinline void storeHitByIndex(RayStreamT& rayN, const vboolx& valid, const vintx& index, const RayK<VSIZEX>& ray, IntersectContext* context) {
+      rayN.setHitByIndex(valid, index, ray);
+    }
+
     template<bool intersect>
     __forceinline void RayStreamFilter::filterAOS(Scene* scene, void* _rayN, size_t N, size_t stride, IntersectContext* context)
     {
@@ -64,7 +85,7 @@ namespace embree
             const vboolx valid = vij < vintx(int(N));
             const vintx offset = vij * int(stride);
             const size_t packetIndex = j / VSIZEX;
-            rayN.setHitByOffset(valid, offset, rays[packetIndex]);
+            storeHitByOffset(rayN, valid, offset, rays[packetIndex], context);
           }
         }
       }
@@ -161,7 +182,7 @@ namespace embree
 
           scene->intersectors.intersect(valid, ray, context);
 
-          rayN.setHitByOffset(valid, offset, ray);
+          storeHitByOffset(rayN, valid, offset, ray, context);
         }
       }
     }
@@ -206,7 +227,7 @@ namespace embree
             const vboolx valid = vij < vintx(int(N));
             const size_t packetIndex = j / VSIZEX;
 
-            rayN.setHitByIndex(valid, vij, rays[packetIndex]);
+            storeHitByIndex(rayN, valid, vij, rays[packetIndex], context);
           }
         }
       }
@@ -302,7 +323,7 @@ namespace embree
 
           scene->intersectors.intersect(valid, ray, context);
 
-          rayN.setHitByIndex(valid, vi, ray);
+          storeHitByIndex(rayN, valid, vi, ray, context);
         }
       }
     }
@@ -456,7 +477,7 @@ namespace embree
 
             scene->intersectors.intersect(valid, ray, context);
 
-            rayN.setHitByOffset(valid, offset, ray);
+            storeHitByOffset(rayN, valid, offset, ray, context);
           }
         }
       }
@@ -504,7 +525,7 @@ namespace embree
             const size_t offset = (i+j) * sizeof(float);
             const size_t packetIndex = j / VSIZEX;
 
-            rayN.setHitByOffset(valid, offset, rays[packetIndex]);
+            storeHitByOffset(rayN, valid, offset, rays[packetIndex], context);
           }
         }
       }
@@ -601,7 +622,7 @@ namespace embree
 
           scene->intersectors.intersect(valid, ray, context);
 
-          rayN.setHitByOffset(valid, offset, ray);
+          storeHitByOffset(rayN, valid, offset, ray, context);
         }
       }
     }
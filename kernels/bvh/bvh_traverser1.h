@@ -929,5 +929,102 @@ namespace embree
     public:
       __forceinline explicit BVHNNodeTraverser1(const TravRayBase<N,Nx,robust>& tray) : BVHNNodeTraverser1Transform<N, Nx, robust, types, (bool)(types & BVH_FLAG_TRANSFORM_NODE)>(tray) {}
     };
+
+    /*! Level of detail selection for single rays. Children of aligned
+     *  nodes that are smaller than the footprint of the ray cone at
+     *  their entry distance are not traversed, but get replaced by a
+     *  proxy hit of a representative primitive of the subtree. */
+    template<int N, int Nx>
+      class BVHNNodeTraverser1Lod
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::AlignedNode AlignedNode;
+
+    public:
+      __forceinline explicit BVHNNodeTraverser1Lod(const IntersectContext* context)
+        : width(context->user->lodConeWidth), angle(context->user->lodConeAngle) {}
+
+      __forceinline bool enabled() const {
+        return width > 0.0f || angle > 0.0f;
+      }
+
+      /*! returns the hit children that are smaller than the ray footprint */
+      __forceinline size_t proxyMask(const NodeRef& cur, size_t mask, const vfloat<Nx>& tNear) const
+      {
+        if (!cur.isAlignedNode()) return 0;
+        const AlignedNode* node = cur.alignedNode();
+        size_t proxies = 0;
+        for (size_t m=mask; m!=0; )
+        {
+          const size_t i = __bscf(m);
+          const Vec3fa size = node->bounds(i).size();
+          if (max(size.x,size.y,size.z) <= madd(angle,tNear[i],width))
+            proxies |= (size_t)1 << i;
+        }
+        return proxies;
+      }
+
+      /*! returns the leftmost leaf of a subtree, or the empty node if the subtree contains non-aligned nodes */
+      static __forceinline NodeRef representative(NodeRef cur)
+      {
+        while (!cur.isLeaf()) {
+          if (!cur.isAlignedNode()) return BVH::emptyNode;
+          cur = cur.alignedNode()->child(0);
+        }
+        return cur;
+      }
+
+      /*! returns the normal of the box face the ray enters the box through */
+      static __forceinline Vec3fa entryNormal(const BBox3fa& box, const Vec3fa& org, const Vec3fa& dir)
+      {
+        const Vec3fa rdir = rcp_safe(dir);
+        const Vec3fa tlower = min((box.lower-org)*rdir,(box.upper-org)*rdir);
+        if (tlower.x >= tlower.y && tlower.x >= tlower.z) return Vec3fa(dir.x < 0.0f ? 1.0f : -1.0f, 0.0f, 0.0f);
+        if (tlower.y >= tlower.z)                         return Vec3fa(0.0f, dir.y < 0.0f ? 1.0f : -1.0f, 0.0f);
+        return Vec3fa(0.0f, 0.0f, dir.z < 0.0f ? 1.0f : -1.0f);
+      }
+
+    private:
+      float width; //!< footprint width at the ray origin
+      float angle; //!< footprint growth per unit distance
+    };
+
+    /*! Counts the traversal steps of a single ray in registers and adds them to
+     *  the traversal statistics of the intersection context when the ray finishes. */
+    class BVHNodeTraverser1Statistics
+    {
+    public:
+      __forceinline BVHNodeTraverser1Statistics(const IntersectContext* context, bool occluded)
+        : counters(context->getTraversalCounters(occluded)), nodes(0), leaves(0), prims(0), depth(0) {}
+
+      __forceinline ~BVHNodeTraverser1Statistics()
+      {
+        if (likely(counters == nullptr)) return;
+        counters->nodeVisits += nodes;
+        counters->leafVisits += leaves;
+        counters->primitiveTests += prims;
+        counters->maxStackDepth = max(size_t(counters->maxStackDepth),depth);
+      }
+
+      __forceinline void node() {
+        nodes++;
+      }
+
+      /*! counts a leaf, the stack depth is tracked at leaves where it peaks */
+      __forceinline void leaf(size_t num, size_t stackDepth)
+      {
+        leaves++;
+        prims += num;
+        depth = max(depth,stackDepth);
+      }
+
+    private:
+      RTCTraversalCounters* counters;
+      size_t nodes;
+      size_t leaves;
+      size_t prims;
+      size_t depth;
+    };
   }
 }
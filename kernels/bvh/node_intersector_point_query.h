@@ -0,0 +1,276 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "node_intersector.h"
+#include "../common/point_query.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    //////////////////////////////////////////////////////////////////////////////////////
+    // Point query structure used in single point query traversal
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N>
+    struct TravPointQuery
+    {
+      __forceinline TravPointQuery () {}
+
+      __forceinline TravPointQuery (const Vec3fa& org, const float radius)
+        : org(Vec3vf<N>(org.x,org.y,org.z)), rad2(radius*radius) {}
+
+      /*! shrinks the query sphere to the new radius */
+      __forceinline void setRadius(const float radius) {
+        rad2 = vfloat<N>(radius*radius);
+      }
+
+    public:
+      Vec3vf<N> org;  //!< query position
+      vfloat<N> rad2; //!< squared query radius
+    };
+
+    /*! Squared distance of the query point to N boxes. */
+    template<int N>
+      __forceinline vfloat<N> pointQueryBoxDistance(const TravPointQuery<N>& query, const Vec3vf<N>& lower, const Vec3vf<N>& upper)
+    {
+      const Vec3vf<N> d = min(max(query.org,lower),upper) - query.org;
+      return dot(d,d);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // AlignedNode point query
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N, int Nx>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::AlignedNode* node, const TravPointQuery<N>& query, vfloat<Nx>& dist)
+    {
+      const Vec3vf<N> lower(node->lower_x,node->lower_y,node->lower_z);
+      const Vec3vf<N> upper(node->upper_x,node->upper_y,node->upper_z);
+      const vfloat<N> d = pointQueryBoxDistance(query,lower,upper);
+      const vbool<N> vmask = (lower.x <= upper.x) & (d <= query.rad2);
+      dist = vfloat<Nx>(d);
+      return movemask(vmask);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // AlignedNodeMB point query
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N>
+      __forceinline vbool<N> pointQueryNodeMB(const typename BVHN<N>::AlignedNodeMB* node, const TravPointQuery<N>& query, const float time, vfloat<N>& dist)
+    {
+      const vfloat<N> t(time);
+      const Vec3vf<N> lower(madd(t,node->lower_dx,node->lower_x),madd(t,node->lower_dy,node->lower_y),madd(t,node->lower_dz,node->lower_z));
+      const Vec3vf<N> upper(madd(t,node->upper_dx,node->upper_x),madd(t,node->upper_dy,node->upper_y),madd(t,node->upper_dz,node->upper_z));
+      dist = pointQueryBoxDistance(query,lower,upper);
+      return (lower.x <= upper.x) & (dist <= query.rad2);
+    }
+
+    template<int N, int Nx>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::AlignedNodeMB* node, const TravPointQuery<N>& query, const float time, vfloat<Nx>& dist)
+    {
+      vfloat<N> d;
+      const vbool<N> vmask = pointQueryNodeMB(node,query,time,d);
+      dist = vfloat<Nx>(d);
+      return movemask(vmask);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // AlignedNodeMB4D point query
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N, int Nx>
+      __forceinline size_t pointQueryNodeMB4D(const typename BVHN<N>::NodeRef ref, const TravPointQuery<N>& query, const float time, vfloat<Nx>& dist)
+    {
+      const typename BVHN<N>::AlignedNodeMB* node = ref.alignedNodeMB();
+      vfloat<N> d;
+      vbool<N> vmask = pointQueryNodeMB(node,query,time,d);
+      if (unlikely(ref.isAlignedNodeMB4D())) {
+        const typename BVHN<N>::AlignedNodeMB4D* node1 = (const typename BVHN<N>::AlignedNodeMB4D*) node;
+        vmask &= (node1->lower_t <= time) & (time < node1->upper_t);
+      }
+      dist = vfloat<Nx>(d);
+      return movemask(vmask);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // QuantizedNode point query
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N, int Nx>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::QuantizedNode* node, const TravPointQuery<N>& query, vfloat<Nx>& dist)
+    {
+      const Vec3vf<N> lower(node->dequantizeLowerX(),node->dequantizeLowerY(),node->dequantizeLowerZ());
+      const Vec3vf<N> upper(node->dequantizeUpperX(),node->dequantizeUpperY(),node->dequantizeUpperZ());
+      const vfloat<N> d = pointQueryBoxDistance(query,lower,upper);
+      const vbool<N> vmask = (lower.x <= upper.x) & (d <= query.rad2);
+      dist = vfloat<Nx>(d);
+      return movemask(vmask);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // UnalignedNode point query
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    /*! The node spaces are rotations followed by a per axis scaling
+     *  into the unit box, thus the norm of the rows of the linear
+     *  part converts distances in node space back to world space. */
+    template<int N>
+      __forceinline vfloat<N> pointQueryUnalignedDistance(const AffineSpace3vf<N>& space, const TravPointQuery<N>& query, const Vec3vf<N>& lower, const Vec3vf<N>& upper)
+    {
+      const Vec3vf<N> p = xfmPoint(space,query.org);
+      const Vec3vf<N> d = min(max(p,lower),upper) - p;
+      const Vec3vf<N> s2(madd(space.l.vx.x,space.l.vx.x,madd(space.l.vy.x,space.l.vy.x,space.l.vz.x*space.l.vz.x)),
+                         madd(space.l.vx.y,space.l.vx.y,madd(space.l.vy.y,space.l.vy.y,space.l.vz.y*space.l.vz.y)),
+                         madd(space.l.vx.z,space.l.vx.z,madd(space.l.vy.z,space.l.vy.z,space.l.vz.z*space.l.vz.z)));
+      return d.x*d.x/s2.x + d.y*d.y/s2.y + d.z*d.z/s2.z;
+    }
+
+    template<int N>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::UnalignedNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
+    {
+      dist = pointQueryUnalignedDistance(node->naabb,query,Vec3vf<N>(zero),Vec3vf<N>(one));
+      return movemask(dist <= query.rad2);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // UnalignedNodeMB point query
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::UnalignedNodeMB* node, const TravPointQuery<N>& query, const float time, vfloat<N>& dist)
+    {
+      const Vec3vf<N> lower = lerp(Vec3vf<N>(zero),node->b1.lower,vfloat<N>(time));
+      const Vec3vf<N> upper = lerp(Vec3vf<N>(one ),node->b1.upper,vfloat<N>(time));
+      dist = pointQueryUnalignedDistance(node->space0,query,lower,upper);
+      return movemask(dist <= query.rad2);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // Node point queries used in point query traversal
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    /*! Computes the squared distances of N nodes to the query point and culls the nodes outside the query sphere */
+    template<int N, int Nx, int types>
+    struct BVHNNodePointQuery1;
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_AN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNode(node.alignedNode(), query, dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_AN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNode(node.alignedNodeMB(), query, time, dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_AN2_AN4D>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNodeMB4D<N>(node, query, time, dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_AN1_UN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (likely(node.isAlignedNode()))          mask = pointQueryNode(node.alignedNode(), query, dist);
+        else if (unlikely(node.isUnalignedNode())) mask = pointQueryNode(node.unalignedNode(), query, dist);
+        else return false;
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_AN2_UN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (likely(node.isAlignedNodeMB()))           mask = pointQueryNode(node.alignedNodeMB(), query, time, dist);
+        else if (unlikely(node.isUnalignedNodeMB()))  mask = pointQueryNode(node.unalignedNodeMB(), query, time, dist);
+        else return false;
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_AN2_AN4D_UN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (unlikely(node.isUnalignedNodeMB())) mask = pointQueryNode(node.unalignedNodeMB(), query, time, dist);
+        else                                    mask = pointQueryNodeMB4D(node, query, time, dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_TN_AN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (likely(node.isAlignedNode())) mask = pointQueryNode(node.alignedNode(), query, dist);
+        else return false;
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_TN_AN1_AN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (likely(node.isAlignedNode()))        mask = pointQueryNode(node.alignedNode(), query, dist);
+        else if (likely(node.isAlignedNodeMB())) mask = pointQueryNode(node.alignedNodeMB(), query, time, dist);
+        else return false;
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodePointQuery1<N, Nx, BVH_QN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNode((const typename BVHN<N>::QuantizedNode*)node.quantizedNode(), query, dist);
+        return true;
+      }
+    };
+  }
+}
@@ -19,6 +19,7 @@
 #include "default.h"
 #include "ray.h"
 #include "context.h"
+#include "point_query.h"
 
 namespace embree
 {
@@ -121,15 +122,23 @@ namespace embree
                                   RayK<VSIZEX>** ray,  /*!< ray stream to intersect */
                                   const size_t N,      /*!< number of rays in stream */
                                   IntersectContext* context   /*!< layout flags */);
+    /*! Type of point query function pointer. */
+    typedef bool (*PointQueryFunc)(Intersectors* This,  /*!< this pointer to accel */
+                                   PointQuery* query,   /*!< point query, radius shrinks to closest distance */
+                                   PointQueryContext* context);
+
     typedef void (*ErrorFunc) ();
 
     struct Intersector1
     {
       Intersector1 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), name(nullptr) {}
+      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), pointQuery((PointQueryFunc)error), name(nullptr) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, const char* name)
-      : intersect(intersect), occluded(occluded), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(nullptr), name(name) {}
+
+      Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, const char* name)
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), name(name) {}
 
       operator bool() const { return name; }
 
@@ -137,6 +146,7 @@ namespace embree
       static const char* type;
       IntersectFunc intersect;
       OccludedFunc occluded;  
+      PointQueryFunc pointQuery;
       const char* name;
     };
     
@@ -372,6 +382,14 @@ namespace embree
       }
 #endif
 
+      /*! Finds the closest point to the query inside the query radius. */
+      __forceinline bool pointQuery (PointQuery* query, PointQueryContext* context)
+      {
+        /* some primitive types do not support point queries */
+        if (intersector1.pointQuery == nullptr) return false;
+        return intersector1.pointQuery(this,query,context);
+      }
+
       /*! Tests if single ray is occluded by the scene. */
       __forceinline void intersect(RTCRay& ray, IntersectContext* context) {
         occluded(ray, context);
@@ -428,11 +446,12 @@ namespace embree
     Intersectors intersectors;
   };
 
-#define DEFINE_INTERSECTOR1(symbol,intersector)                              \
-  Accel::Intersector1 symbol() {                                             \
-    return Accel::Intersector1((Accel::IntersectFunc)intersector::intersect, \
-                               (Accel::OccludedFunc )intersector::occluded,  \
-                               TOSTRING(isa) "::" TOSTRING(symbol));         \
+#define DEFINE_INTERSECTOR1(symbol,intersector)                                \
+  Accel::Intersector1 symbol() {                                               \
+    return Accel::Intersector1((Accel::IntersectFunc )intersector::intersect,  \
+                               (Accel::OccludedFunc  )intersector::occluded,   \
+                               (Accel::PointQueryFunc)intersector::pointQuery, \
+                               TOSTRING(isa) "::" TOSTRING(symbol));           \
   }
   
 #define DEFINE_INTERSECTOR4(symbol,intersector)                               \
@@ -147,6 +147,16 @@ namespace embree
       This->validAccels[i]->intersectors.occludedN(ray,M,context);
   }
 
+  bool AccelN::pointQuery (Accel::Intersectors* This_in, PointQuery* query, PointQueryContext* context)
+  {
+    /* the query radius shrinks over all acceleration structures */
+    AccelN* This = (AccelN*)This_in->ptr;
+    bool changed = false;
+    for (size_t i=0; i<This->validAccels.size(); i++)
+      changed |= This->validAccels[i]->intersectors.pointQuery(query,context);
+    return changed;
+  }
+
   void AccelN::print(size_t ident)
   {
     for (size_t i=0; i<validAccels.size(); i++)
@@ -170,6 +180,23 @@ namespace embree
         accels[i]->build();
       });
 
+    updateValidAccels();
+  }
+
+  AccelN* AccelN::detach()
+  {
+    AccelN* accelN = new AccelN;
+    for (size_t i=0; i<accels.size(); i++)
+      accelN->add(accels[i]);
+    accelN->updateValidAccels();
+    
+    accels.clear();
+    validAccels.clear();
+    return accelN;
+  }
+
+  void AccelN::updateValidAccels()
+  {
     /* create list of non-empty acceleration structures */
     validAccels.clear();
     bool valid1 = true;
@@ -191,7 +218,7 @@ namespace embree
     else 
     {
       intersectors.ptr = this;
-      intersectors.intersector1  = Intersector1(&intersect,&occluded,valid1 ? "AccelN::intersector1": nullptr);
+      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,valid1 ? "AccelN::intersector1": nullptr);
       intersectors.intersector4  = Intersector4(&intersect4,&occluded4,valid4 ? "AccelN::intersector4" : nullptr);
       intersectors.intersector8  = Intersector8(&intersect8,&occluded8,valid8 ? "AccelN::intersector8" : nullptr);
       intersectors.intersector16 = Intersector16(&intersect16,&occluded16,valid16 ? "AccelN::intersector16": nullptr);
@@ -45,14 +45,23 @@ namespace embree
     static void occluded16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context);
     static void occludedN (Accel::Intersectors* This, RayK<VSIZEX>** ray, const size_t N, IntersectContext* context);
 
+  public:
+    static bool pointQuery (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+
   public:
     void print(size_t ident);
     void immutable();
     void build ();
+
+    /*! moves all acceleration structures into a new AccelN object, which can get traced while new acceleration structures get build */
+    AccelN* detach();
     void select(bool filter);
     void deleteGeometry(size_t geomID);
     void clear ();
 
+  private:
+    void updateValidAccels();
+
   public:
     darray_t<Accel*,16> accels;
     darray_t<Accel*,16> validAccels;
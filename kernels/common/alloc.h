@@ -462,6 +462,13 @@ namespace embree
       thread_local_allocators.clear();
     }
 
+    /*! returns the unused memory of OS allocated blocks after the build */
+    void shrink ()
+    {
+      internal_fix_used_blocks();
+      if (usedBlocks.load() != nullptr) usedBlocks.load()->shrink_list(device);
+    }
+
     /*! frees all allocated memory */
     __forceinline void clear()
     {
@@ -736,37 +743,25 @@ namespace embree
           bytesReserve  = ((bytesReserve +PAGE_SIZE-1) & ~(PAGE_SIZE-1));
         }
 
-        /* either use alignedMalloc or os_malloc */
+        /* either use alignedMalloc or os_malloc, or the allocator of the device */
         void *ptr = nullptr;
         if (atype == ALIGNED_MALLOC)
         {
-          /* special handling for default block size */
-          if (bytesAllocate == (2*PAGE_SIZE_2M))
-          {
-            const size_t alignment = maxAlignment;
-            if (device) device->memoryMonitor(bytesAllocate+alignment,false);
-            ptr = alignedMalloc(bytesAllocate,alignment);
-
-            /* give hint to transparently convert these pages to 2MB pages */
-            const size_t ptr_aligned_begin = ((size_t)ptr) & ~size_t(PAGE_SIZE_2M-1);
-            os_advise((void*)(ptr_aligned_begin +              0),PAGE_SIZE_2M); // may fail if no memory mapped before block
-            os_advise((void*)(ptr_aligned_begin + 1*PAGE_SIZE_2M),PAGE_SIZE_2M);
-            os_advise((void*)(ptr_aligned_begin + 2*PAGE_SIZE_2M),PAGE_SIZE_2M); // may fail if no memory mapped after block
-
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
-          }
-          else
-          {
-            const size_t alignment = maxAlignment;
-            if (device) device->memoryMonitor(bytesAllocate+alignment,false);
-            ptr = alignedMalloc(bytesAllocate,alignment);
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
-          }
+          const size_t alignment = maxAlignment;
+          if (device) device->memoryMonitor(bytesAllocate+alignment,false);
+
+          /* give hint to transparently convert blocks of default size to 2MB pages */
+          bool huge_pages = bytesAllocate == (2*PAGE_SIZE_2M);
+          if (device) ptr = device->memoryAlloc(bytesAllocate,alignment,false,huge_pages);
+          else      { ptr = alignedMalloc(bytesAllocate,alignment); huge_pages = false; }
+          return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,huge_pages);
         }
         else if (atype == OS_MALLOC)
         {
           if (device) device->memoryMonitor(bytesAllocate,false);
-          bool huge_pages; ptr = os_malloc(bytesReserve,huge_pages);
+          bool huge_pages = false;
+          if (device) ptr = device->memoryAlloc(bytesReserve,PAGE_SIZE,true,huge_pages);
+          else        ptr = os_malloc(bytesReserve,huge_pages);
           return new (ptr) Block(OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages);
         }
         else
@@ -807,13 +802,16 @@ namespace embree
         const ssize_t sizeof_Alloced = wasted+sizeof_Header+getBlockAllocatedBytes();
 
         if (atype == ALIGNED_MALLOC) {
-          alignedFree(this);
+          const size_t sizeof_This = sizeof_Header+reserveEnd;
+          if (device) device->memoryFree(this,sizeof_This,false,huge_pages);
+          else        alignedFree(this);
           if (device) device->memoryMonitor(-sizeof_Alloced,true);
         }
 
         else if (atype == OS_MALLOC) {
-         size_t sizeof_This = sizeof_Header+reserveEnd;
-         os_free(this,sizeof_This,huge_pages);
+         const size_t sizeof_This = sizeof_Header+reserveEnd;
+         if (device) device->memoryFree(this,sizeof_This,true,huge_pages);
+         else        os_free(this,sizeof_This,huge_pages);
          if (device) device->memoryMonitor(-sizeof_Alloced,true);
         }
 
@@ -821,6 +819,27 @@ namespace embree
         }
       }
 
+      void shrink_list(MemoryMonitorInterface* device)
+      {
+        for (Block* block = this; block; block = block->next)
+          block->shrink_block(device);
+      }
+
+      /*! returns the unused memory at the end of OS allocated blocks */
+      void shrink_block (MemoryMonitorInterface* device)
+      {
+        if (atype != OS_MALLOC) return;
+        const size_t sizeof_Header = offsetof(Block,data[0]);
+        const size_t bytesOld = sizeof_Header+reserveEnd;
+        const size_t bytesNew = sizeof_Header+getBlockUsedBytes();
+        const size_t bytes = device ? device->memoryShrink(this,bytesNew,bytesOld,huge_pages) : os_shrink(this,bytesNew,bytesOld,huge_pages);
+        reserveEnd = bytes-sizeof_Header;
+
+        const size_t allocEndNew = min(allocEnd,reserveEnd);
+        if (device) device->memoryMonitor(-ssize_t(allocEnd-allocEndNew),true);
+        allocEnd = allocEndNew;
+      }
+
       void* malloc(MemoryMonitorInterface* device, size_t& bytes_in, size_t align, bool partial)
       {
         size_t bytes = bytes_in;
@@ -0,0 +1,174 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Keeps the memory of large build temporaries (primitive reference
+   *  arrays, morton code arrays, ...) alive across builds. Freed blocks
+   *  are cached up to a high-water mark and handed out again to later
+   *  allocations of similar size, thus repeated commits do not page
+   *  fault through fresh memory each time. Cached blocks stay reported
+   *  to the memory monitor as in use, and the cache gets released when
+   *  the memory monitor denies an allocation. */
+  class BuildArena
+  {
+    struct Block
+    {
+      __forceinline Block () {}
+
+      __forceinline Block (void* ptr, size_t bytes, size_t align, bool os, bool hugepages)
+        : ptr(ptr), bytes(bytes), align(align), os(os), hugepages(hugepages) {}
+
+    public:
+      void* ptr;      //!< start of the block
+      size_t bytes;   //!< size the block got allocated with
+      size_t align;   //!< alignment the block got allocated with
+      bool os;        //!< true if the block got allocated from the OS
+      bool hugepages; //!< true if the block uses huge pages
+    };
+
+  public:
+
+    /*! smaller allocations are not worth caching */
+    static const size_t minBlockBytes = 64*1024;
+
+    BuildArena (MemoryMonitorInterface* device)
+      : device(device), maxBytes(0), cachedBytes(0) {}
+
+    ~BuildArena () {
+      assert(cached.size() == 0);
+    }
+
+    /*! allocates a block, reusing a cached block if one of similar size is available */
+    void* alloc(size_t bytes, size_t align, bool os, bool& hugepages)
+    {
+      if (bytes < minBlockBytes) {
+        device->memoryMonitor(bytes,false);
+        return device->memoryAlloc(bytes,align,os,hugepages);
+      }
+
+      {
+        Lock<SpinLock> lock(mutex);
+
+        /* best fit that wastes at most half of the cached block */
+        size_t best = size_t(-1);
+        for (size_t i=0; i<cached.size(); i++)
+        {
+          const Block& block = cached[i];
+          if (block.bytes < bytes || block.bytes > 2*bytes || block.align < align) continue;
+          if (best == size_t(-1) || block.bytes < cached[best].bytes) best = i;
+        }
+
+        if (best != size_t(-1))
+        {
+          const Block block = cached[best];
+          cached[best] = cached.back();
+          cached.pop_back();
+          cachedBytes -= block.bytes;
+          used[block.ptr] = block;
+          hugepages = block.hugepages;
+          return block.ptr;
+        }
+      }
+
+      device->memoryMonitor(bytes,false);
+      void* ptr = device->memoryAlloc(bytes,align,os,hugepages);
+      Lock<SpinLock> lock(mutex);
+      used[ptr] = Block(ptr,bytes,align,os,hugepages);
+      return ptr;
+    }
+
+    /*! frees a block, the block gets cached if the high-water mark permits */
+    void free(void* ptr, size_t bytes, bool os, bool hugepages)
+    {
+      if (ptr == nullptr) return;
+      if (bytes < minBlockBytes) {
+        device->memoryFree(ptr,bytes,os,hugepages);
+        device->memoryMonitor(-ssize_t(bytes),true);
+        return;
+      }
+
+      Block block;
+      {
+        Lock<SpinLock> lock(mutex);
+        std::map<void*,Block>::iterator i = used.find(ptr);
+        assert(i != used.end());
+        block = i->second;
+        used.erase(i);
+
+        if (cachedBytes+block.bytes <= maxBytes) {
+          cached.push_back(block);
+          cachedBytes += block.bytes;
+          return;
+        }
+      }
+      device->memoryFree(block.ptr,block.bytes,block.os,block.hugepages);
+      device->memoryMonitor(-ssize_t(block.bytes),true);
+    }
+
+    /*! sets the high-water mark and frees cached blocks exceeding it */
+    void setMaxBytes(size_t bytes)
+    {
+      std::vector<Block> release;
+      {
+        Lock<SpinLock> lock(mutex);
+        maxBytes = bytes;
+
+        /* release large blocks first */
+        std::sort(cached.begin(),cached.end(),[] (const Block& a, const Block& b) { return a.bytes < b.bytes; });
+        while (cachedBytes > maxBytes) {
+          release.push_back(cached.back());
+          cachedBytes -= cached.back().bytes;
+          cached.pop_back();
+        }
+      }
+      for (size_t i=0; i<release.size(); i++) {
+        device->memoryFree(release[i].ptr,release[i].bytes,release[i].os,release[i].hugepages);
+        device->memoryMonitor(-ssize_t(release[i].bytes),true);
+      }
+    }
+
+    /*! frees all cached blocks */
+    void clear()
+    {
+      const size_t bytes = getMaxBytes();
+      setMaxBytes(0);
+      setMaxBytes(bytes);
+    }
+
+    /*! returns the high-water mark */
+    size_t getMaxBytes() const {
+      return maxBytes;
+    }
+
+    /*! returns the number of bytes currently cached */
+    size_t getCachedBytes() const {
+      return cachedBytes;
+    }
+
+  private:
+    MemoryMonitorInterface* device;
+    SpinLock mutex;
+    std::atomic<size_t> maxBytes;       //!< maximal number of bytes to cache
+    std::atomic<size_t> cachedBytes;    //!< number of bytes in cached blocks
+    std::vector<Block> cached;          //!< freed blocks available for reuse
+    std::map<void*,Block> used;         //!< blocks handed out by the arena
+  };
+}
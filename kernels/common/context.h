@@ -32,6 +32,83 @@ namespace embree
     __forceinline bool hasContextFilter() const {
       return user->filter != nullptr;
     }
+
+    __forceinline bool hasHitCollection() const {
+      return user->hitCollections != nullptr;
+    }
+
+    /*! returns the traversal counters of the specified query type, or nullptr if the context gathers no statistics */
+    __forceinline RTCTraversalCounters* getTraversalCounters(bool occluded) const
+    {
+      RTCTraversalStatistics* statistics = user->statistics;
+      if (likely(statistics == nullptr)) return nullptr;
+      return occluded ? &statistics->occluded : &statistics->intersect;
+    }
+
+    /*! counts an invoked filter function in the traversal statistics of the context */
+    __forceinline void countFilterCall(bool occluded) const
+    {
+      RTCTraversalCounters* counters = getTraversalCounters(occluded);
+      if (unlikely(counters != nullptr)) counters->filterCalls++;
+    }
+
+    /*! Tests the bit of the geometry with the specified ID in the visibility bitset of the
+     *  context. Culled geometries are rejected before filter functions or user callbacks run. */
+    __forceinline bool isGeometryVisible(const unsigned geomID) const
+    {
+      const unsigned* visibility = user->geometryVisibility;
+      return visibility == nullptr || ((visibility[geomID/32] >> (geomID%32)) & 1);
+    }
+
+    /*! Clears all lanes whose geometry is culled by the visibility bitset of the context. */
+    template<int Mx, int M>
+    __forceinline vbool<Mx> cullInvisibleGeometries(const vbool<Mx>& valid_i, const vint<M>& geomIDs) const
+    {
+      vbool<Mx> valid = valid_i;
+      if (likely(user->geometryVisibility == nullptr)) return valid;
+      for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m))
+        if (!isGeometryVisible(geomIDs[j])) clear(valid,j);
+      return valid;
+    }
+
+    /*! Records a hit in the hit collection of the ray with the specified ID. Hits are
+     *  kept sorted by distance, and once the collection is full the farthest hit gets
+     *  replaced and tfar shrinks to the distance of the farthest collected hit. */
+    void collectHit(const unsigned rayID, float& tfar, const float t, const Vec3fa& Ng, const float u, const float v,
+                    const unsigned primID, const unsigned geomID, const unsigned instID) const
+    {
+      RTCHitCollection& collection = user->hitCollections[rayID];
+      RTCCollectedHit* hits = collection.hits;
+      size_t num = collection.hitCount;
+
+      /* primitives referenced by multiple leaves report the same hit multiple times */
+      for (size_t i=0; i<num; i++)
+        if (hits[i].t == t && hits[i].primID == primID && hits[i].geomID == geomID && hits[i].instID == instID)
+          return;
+
+      if (num == collection.maxHitCount) {
+        if (num == 0 || t >= hits[num-1].t) return;
+        num--;
+      }
+
+      /* sorted insertion */
+      size_t i = num;
+      for (; i>0 && hits[i-1].t > t; i--)
+        hits[i] = hits[i-1];
+      hits[i].t = t;
+      hits[i].Ng_x = Ng.x;
+      hits[i].Ng_y = Ng.y;
+      hits[i].Ng_z = Ng.z;
+      hits[i].u = u;
+      hits[i].v = v;
+      hits[i].primID = primID;
+      hits[i].geomID = geomID;
+      hits[i].instID = instID;
+      collection.hitCount = unsigned(num+1);
+
+      if (collection.hitCount == collection.maxHitCount)
+        tfar = min(tfar,hits[num].t);
+    }
     
   public:
     Scene* scene;
@@ -48,9 +48,10 @@ namespace embree
   static MutexSys g_mutex;
   static std::map<Device*,size_t> g_cache_size_map;
   static std::map<Device*,size_t> g_num_threads_map;
+  static std::map<Device*,size_t> g_num_user_threads_map;
 
   Device::Device (const char* cfg, bool singledevice)
-    : State(singledevice)
+    : State(singledevice), numAllocations(0), hugepageBytes(0), buildArena(this)
   {
     /* check CPU */
     if (!hasISA(ISA)) 
@@ -73,10 +74,17 @@ namespace embree
       State::hugepages_success &= win_enable_selockmemoryprivilege(State::verbosity(3));
 #endif
     State::hugepages_success &= os_init(State::hugepages,State::verbosity(3));
+
+    /*! transparent huge pages do not depend on the reserved huge pages */
+    if (State::transparent_hugepages)
+      State::transparent_hugepages = os_init_transparent_hugepages(State::verbosity(3));
     
     /*! set tessellation cache size */
     setCacheSize( State::tessellation_cache_size );
 
+    /*! set high-water mark of build arena */
+    buildArena.setMaxBytes( State::build_arena_size );
+
     /*! enable some floating point exceptions to catch bugs */
     if (State::float_exceptions)
     {
@@ -118,7 +126,14 @@ namespace embree
 
   Device::~Device ()
   {
+    buildArena.clear();
     setCacheSize(0);
+
+    /* joined application threads have to return before the thread pool can get reconfigured */
+#if defined(TASKING_INTERNAL)
+    TaskScheduler::leaveThreadPool(joinedThreads);
+    while (joinedThreads.numThreads > 0) yield();
+#endif
     exitTaskingSystem();
   }
 
@@ -290,12 +305,118 @@ namespace embree
     if (State::memory_monitor_function && bytes != 0) {
       if (!State::memory_monitor_function(State::memory_monitor_userptr,bytes,post)) {
         if (bytes > 0) { // only throw exception when we allocate memory to never throw inside a destructor
+
+          /* memory cached by the build arena gets released before an allocation fails */
+          if (buildArena.getCachedBytes() > 0) {
+            buildArena.clear();
+            if (State::memory_monitor_function(State::memory_monitor_userptr,bytes,post)) return;
+          }
           throw_RTCError(RTC_ERROR_OUT_OF_MEMORY,"memory monitor forced termination");
         }
       }
     }
   }
 
+  void* Device::memoryAlloc(size_t bytes, size_t align, bool os, bool& hugepages)
+  {
+    /* use the allocator of the application if set */
+    if (State::alloc_function)
+    {
+      const bool hint = hugepages || (os && bytes >= PAGE_SIZE_2M);
+      void* ptr = State::alloc_function(State::allocator_userptr,bytes,align,hint ? RTC_ALLOCATION_FLAG_HUGE_PAGES : RTC_ALLOCATION_FLAG_NONE);
+      if (ptr == nullptr)
+        throw_RTCError(RTC_ERROR_OUT_OF_MEMORY,"allocator returned no memory");
+      assert((((size_t)ptr) & (align-1)) == 0);
+      numAllocations++;
+      hugepages = false;
+      return ptr;
+    }
+
+    void* ptr = nullptr;
+    if (os) {
+      ptr = os_malloc(bytes,hugepages,State::transparent_hugepages);
+    }
+
+    /* large allocations cover full 2MB pages that can get converted to transparent huge pages */
+    else if (State::transparent_hugepages && bytes >= PAGE_SIZE_2M)
+    {
+      ptr = alignedMalloc(bytes,max(align,size_t(PAGE_SIZE_2M)));
+      os_advise(ptr,bytes);
+      hugepages = true;
+    }
+
+    else
+    {
+      ptr = alignedMalloc(bytes,align);
+
+      /* give hint to transparently convert the pages of this allocation to 2MB pages */
+      if (hugepages) {
+        for (size_t p = ((size_t)ptr) & ~size_t(PAGE_SIZE_2M-1); p < (size_t)ptr+bytes; p += PAGE_SIZE_2M)
+          os_advise((void*)p,PAGE_SIZE_2M); // may fail if no memory is mapped before or after the allocation
+      }
+      hugepages = false;
+    }
+    if (ptr) numAllocations++;
+    if (ptr && hugepages) hugepageBytes += bytes;
+    return ptr;
+  }
+
+  void Device::memoryFree(void* ptr, size_t bytes, bool os, bool hugepages)
+  {
+    if (ptr == nullptr) return;
+    numAllocations--;
+
+    /* for small aligned allocations the huge page flag is only a hint */
+    if (hugepages && (os || bytes >= PAGE_SIZE_2M))
+      hugepageBytes -= bytes;
+
+    if (State::free_function) State::free_function(State::allocator_userptr,ptr,bytes);
+    else if (os)              os_free(ptr,bytes,hugepages);
+    else                      alignedFree(ptr);
+  }
+
+  size_t Device::memoryShrink(void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages)
+  {
+    if (State::alloc_function) {
+      if (State::shrink_function == nullptr) return bytesOld;
+      return min(bytesOld,max(bytesNew,State::shrink_function(State::allocator_userptr,ptr,bytesNew,bytesOld)));
+    }
+
+    /* without an application allocator only blocks of transparent huge pages get shrunk */
+    if (!hugepages || !State::transparent_hugepages) return bytesOld;
+    const size_t bytes = os_shrink(ptr,bytesNew,bytesOld,hugepages,State::transparent_hugepages);
+    if (hugepages) hugepageBytes += ssize_t(bytes)-ssize_t(bytesOld);
+    return bytes;
+  }
+
+  void* Device::arenaAlloc(size_t bytes, size_t align, bool os, bool& hugepages) {
+    return buildArena.alloc(bytes,align,os,hugepages);
+  }
+
+  void Device::arenaFree(void* ptr, size_t bytes, bool os, bool hugepages) {
+    buildArena.free(ptr,bytes,os,hugepages);
+  }
+
+  void Device::setAllocator(RTCAllocFunction alloc, RTCFreeFunction free, RTCShrinkFunction shrink, void* uptr)
+  {
+    if ((alloc == nullptr) != (free == nullptr))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"alloc and free function have to get set together");
+
+    /* the tessellation cache gets reallocated through the new allocator */
+    buildArena.clear();
+    setCacheSize(0);
+    if (numAllocations != 0) {
+      setCacheSize(State::tessellation_cache_size);
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"allocator can only get set while no memory is allocated through the device");
+    }
+    
+    State::alloc_function = alloc;
+    State::free_function = free;
+    State::shrink_function = shrink;
+    State::allocator_userptr = uptr;
+    setCacheSize(State::tessellation_cache_size);
+  }
+
   size_t getMaxNumThreads()
   {
     size_t maxNumThreads = 0;
@@ -306,11 +427,23 @@ namespace embree
     return maxNumThreads;
   }
 
-  size_t getMaxCacheSize()
+  size_t getMaxNumUserThreads()
+  {
+    size_t maxNumUserThreads = 0;
+    for (std::map<Device*,size_t>::iterator i=g_num_user_threads_map.begin(); i != g_num_user_threads_map.end(); i++)
+      maxNumUserThreads = max(maxNumUserThreads, (*i).second);
+    return maxNumUserThreads;
+  }
+
+  size_t getMaxCacheSize(Device*& maxCacheDevice)
   {
     size_t maxCacheSize = 0;
-    for (std::map<Device*,size_t>::iterator i=g_cache_size_map.begin(); i!= g_cache_size_map.end(); i++)
-      maxCacheSize = max(maxCacheSize, (*i).second);
+    maxCacheDevice = nullptr;
+    for (std::map<Device*,size_t>::iterator i=g_cache_size_map.begin(); i!= g_cache_size_map.end(); i++) {
+      if ((*i).second <= maxCacheSize) continue;
+      maxCacheSize = (*i).second;
+      maxCacheDevice = (*i).first;
+    }
     return maxCacheSize;
   }
  
@@ -321,8 +454,10 @@ namespace embree
     if (bytes == 0) g_cache_size_map.erase(this);
     else            g_cache_size_map[this] = bytes;
     
-    size_t maxCacheSize = getMaxCacheSize();
-    resizeTessellationCache(maxCacheSize);
+    /* the cache gets allocated through the device that requested the largest cache */
+    Device* maxCacheDevice = nullptr;
+    size_t maxCacheSize = getMaxCacheSize(maxCacheDevice);
+    resizeTessellationCache(maxCacheSize,maxCacheDevice);
 #endif
   }
 
@@ -333,10 +468,11 @@ namespace embree
       g_num_threads_map[this] = std::numeric_limits<size_t>::max();
     else 
       g_num_threads_map[this] = numThreads;
+    g_num_user_threads_map[this] = numUserThreads;
 
     /* create task scheduler */
     size_t maxNumThreads = getMaxNumThreads();
-    TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
+    TaskScheduler::create(maxNumThreads,getMaxNumUserThreads(),State::set_affinity,State::start_threads);
 #if USE_TASK_ARENA
     arena = make_unique(new tbb::task_arena((int)min(maxNumThreads,TaskScheduler::threadCount())));
 #endif
@@ -346,6 +482,7 @@ namespace embree
   {
     Lock<MutexSys> lock(g_mutex);
     g_num_threads_map.erase(this);
+    g_num_user_threads_map.erase(this);
 
     /* terminate tasking system */
     if (g_num_threads_map.size() == 0) {
@@ -354,7 +491,7 @@ namespace embree
     /* or configure new number of threads */
     else {
       size_t maxNumThreads = getMaxNumThreads();
-      TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
+      TaskScheduler::create(maxNumThreads,getMaxNumUserThreads(),State::set_affinity,State::start_threads);
     }
 #if USE_TASK_ARENA
     arena.reset();
@@ -501,6 +638,16 @@ namespace embree
     case RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED: return 1;
 #endif
 
+    case RTC_DEVICE_PROPERTY_BUILD_ARENA_SIZE: return buildArena.getMaxBytes();
+    case RTC_DEVICE_PROPERTY_BUILD_ARENA_CACHED_BYTES: return buildArena.getCachedBytes();
+    case RTC_DEVICE_PROPERTY_HUGEPAGE_ADVISED_BYTES: return hugepageBytes;
+
+#if defined(TASKING_INTERNAL)
+    case RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT: return joinedThreads.numThreads;
+#else
+    case RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT: return 0;
+#endif
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
@@ -19,6 +19,7 @@
 #include "default.h"
 #include "state.h"
 #include "accel.h"
+#include "build_arena.h"
 
 namespace embree
 {
@@ -59,6 +60,24 @@ namespace embree
     /*! invokes the memory monitor callback */
     void memoryMonitor(ssize_t bytes, bool post);
 
+    /*! allocates memory through the allocator of the application or the internal allocator */
+    void* memoryAlloc(size_t bytes, size_t align, bool os, bool& hugepages);
+
+    /*! frees memory allocated through memoryAlloc */
+    void memoryFree(void* ptr, size_t bytes, bool os, bool hugepages);
+
+    /*! shrinks an OS allocation and returns its new size */
+    size_t memoryShrink(void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages);
+
+    /*! allocates memory of monitored vectors through the build arena */
+    void* arenaAlloc(size_t bytes, size_t align, bool os, bool& hugepages);
+
+    /*! frees memory of monitored vectors through the build arena */
+    void arenaFree(void* ptr, size_t bytes, bool os, bool hugepages);
+
+    /*! sets the allocator of the application, only possible while no memory is allocated through the device */
+    void setAllocator(RTCAllocFunction alloc, RTCFreeFunction free, RTCShrinkFunction shrink, void* uptr);
+
     /*! sets the size of the software cache. */
     void setCacheSize(size_t bytes);
 
@@ -95,8 +114,17 @@ namespace embree
 #if USE_TASK_ARENA
     std::unique_ptr<tbb::task_arena> arena;
 #endif
+
+#if defined(TASKING_INTERNAL)
+    TaskScheduler::JoinedThreads joinedThreads; //!< application threads that joined the thread pool through this device
+#endif
     
     /* ray streams filter */
     RayStreamFilterFuncs rayStreamFilters;
+
+  private:
+    std::atomic<size_t> numAllocations; //!< number of live allocations performed through memoryAlloc
+    std::atomic<ssize_t> hugepageBytes; //!< number of bytes of live allocations that use reserved huge pages or are advised to use transparent huge pages
+    BuildArena buildArena;              //!< keeps build temporaries alive across builds
   };
 }
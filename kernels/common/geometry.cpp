@@ -22,8 +22,9 @@ namespace embree
   Geometry::Geometry (Device* device, Type type, unsigned int numPrimitives, unsigned int numTimeSteps) 
     : device(device), scene(nullptr), geomID(0), type(type), 
       numPrimitives(numPrimitives), numPrimitivesChanged(false),
-      numTimeSteps(unsigned(numTimeSteps)), fnumTimeSegments(float(numTimeSteps-1)), quality(RTC_BUILD_QUALITY_MEDIUM),
-      enabled(true), state(MODIFIED), userPtr(nullptr), mask(-1), used(1),
+      numTimeSteps(unsigned(numTimeSteps)), fnumTimeSegments(float(numTimeSteps-1)), 
+      time_range(0.0f,1.0f), rcp_time_range_size(1.0f), uniform_time_steps(true), quality(RTC_BUILD_QUALITY_MEDIUM),
+      enabled(true), state(MODIFIED), userPtr(nullptr), mask(-1), backfaceCulling(false), used(1),
       intersectionFilterN(nullptr), occlusionFilterN(nullptr)
   {
     device->refInc();
@@ -55,6 +56,61 @@ namespace embree
     numTimeSteps = numTimeSteps_in;
     fnumTimeSegments = float(numTimeSteps_in-1);
     if (isEnabled() && scene) enabling();
+
+    /* individual times of time steps do not carry over */
+    Geometry::setTimeRange(time_range);
+    
+    Geometry::update();
+  }
+
+  void Geometry::setTimeRange (const BBox1f& range)
+  {
+    if (!(range.lower >= 0.0f && range.lower < range.upper && range.upper <= 1.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid time range");
+
+    time_range = range;
+    rcp_time_range_size = 1.0f/range.size();
+    uniform_time_steps = true;
+    time_steps.clear();
+
+    if (numTimeSteps > 1 && (range.lower != 0.0f || range.upper != 1.0f))
+    {
+      time_steps.resize(numTimeSteps);
+      for (size_t i=0; i<numTimeSteps; i++)
+        time_steps[i] = lerp(range.lower,range.upper,float(i)/fnumTimeSegments);
+      time_steps.back() = range.upper;
+    }
+    
+    Geometry::update();
+  }
+
+  void Geometry::setTimeSteps (const float* times)
+  {
+    if (times == nullptr) {
+      setTimeRange(BBox1f(0.0f,1.0f));
+      return;
+    }
+
+    if (numTimeSteps < 2)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"time steps require a motion blurred geometry");
+
+    for (size_t i=0; i<numTimeSteps; i++) {
+      if (!(times[i] >= 0.0f && times[i] <= 1.0f))
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"time step out of [0,1] range");
+      if (i > 0 && !(times[i-1] < times[i]))
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"time steps have to be strictly increasing");
+    }
+
+    time_steps.assign(times,times+numTimeSteps);
+    time_range = BBox1f(times[0],times[numTimeSteps-1]);
+    rcp_time_range_size = 1.0f/time_range.size();
+    uniform_time_steps = false;
+
+    /* uniform spacing over [0,1] uses the faster default path */
+    bool uniform = true;
+    for (size_t i=0; i<numTimeSteps; i++)
+      uniform &= times[i] == float(i)/fnumTimeSegments;
+    if (uniform) time_steps.clear();
     
     Geometry::update();
   }
@@ -101,6 +157,18 @@ namespace embree
     }
   }
 
+  void Geometry::updateBackfaceCulling(bool enable)
+  {
+    if (!backfaceCulling)
+      return;
+
+    if (enable) {
+      scene->numBackfaceCullingGeometries++;
+    } else {
+      scene->numBackfaceCullingGeometries--;
+    }
+  }
+
   Geometry* Geometry::attach(Scene* scene, unsigned int geomID)
   {
     assert(scene);
@@ -109,6 +177,7 @@ namespace embree
     if (isEnabled()) {
       scene->setModified();
       updateIntersectionFilters(true);
+      updateBackfaceCulling(true);
       enabling();
     }
     return this;
@@ -119,6 +188,7 @@ namespace embree
     if (isEnabled()) {
       scene->setModified();
       updateIntersectionFilters(false);
+      updateBackfaceCulling(false);
       disabling();
     }
     this->scene = nullptr;
@@ -132,6 +202,7 @@ namespace embree
 
     if (scene) {
       updateIntersectionFilters(true);
+      updateBackfaceCulling(true);
       scene->setModified();
       enabling();
     }
@@ -147,6 +218,7 @@ namespace embree
 
     if (scene) {
       updateIntersectionFilters(false);
+      updateBackfaceCulling(false);
       scene->setModified();
       disabling();
     }
@@ -172,6 +244,18 @@ namespace embree
     intersectionFilterN = filter;
   }
 
+  void Geometry::setBackfaceCulling (bool enable)
+  {
+    if (type != TRIANGLE_MESH && type != QUAD_MESH)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"backface culling not supported for this geometry");
+
+    if (scene && isEnabled()) {
+      scene->numBackfaceCullingGeometries -= backfaceCulling;
+      scene->numBackfaceCullingGeometries += enable;
+    }
+    backfaceCulling = enable;
+  }
+
   void Geometry::setOcclusionFilterFunctionN (RTCFilterFunctionN filter) 
   { 
     if (type != TRIANGLE_MESH && type != QUAD_MESH && type != LINE_SEGMENTS && type != BEZIER_CURVES && type != SUBDIV_MESH && type != USER_GEOMETRY) 
@@ -23,6 +23,7 @@
 namespace embree
 {
   class Scene;
+  struct QuaternionDecomposition;
 
   /* calculate time segment itime and fractional time ftime */
   __forceinline int getTimeSegment(float time, float numTimeSegments, float& ftime)
@@ -77,6 +78,9 @@ namespace embree
     /*! updates intersection filter function counts in scene */
     void updateIntersectionFilters(bool enable);
 
+    /*! updates backface culling counts in scene */
+    void updateBackfaceCulling(bool enable);
+
   public:
 
     /*! tests if geometry is enabled */
@@ -106,6 +110,12 @@ namespace embree
     /*! sets number of time steps */
     virtual void setNumTimeSteps (unsigned int numTimeSteps_in);
 
+    /*! sets the time range covered by uniformly spaced time steps */
+    virtual void setTimeRange (const BBox1f& range);
+
+    /*! sets the time of each time step, or uniform time steps over [0,1] when times is NULL */
+    virtual void setTimeSteps (const float* times);
+
     /*! sets number of vertex attributes */
     virtual void setVertexAttributeCount (unsigned int N) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -200,6 +210,14 @@ namespace embree
     virtual void setMask(unsigned mask) { 
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
+
+    /*! Enables or disables backface culling. */
+    void setBackfaceCulling(bool enable);
+
+    /*! returns true if back faces get culled, which the intersection context can request for triangle and quad meshes */
+    __forceinline bool cullsBackfaces(const RTCIntersectContextFlags flags) const {
+      return backfaceCulling || ((flags & RTC_INTERSECT_CONTEXT_FLAG_BACKFACE_CULLING) && (type & (TRIANGLE_MESH | QUAD_MESH)));
+    }
     
     /*! Sets specified buffer. */
     virtual void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num) {
@@ -235,6 +253,16 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Sets transformation of the instance as scale, rotation quaternion, and translation */
+    virtual void setQuaternionDecomposition(const QuaternionDecomposition& qd, unsigned int timeStep) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Sets the double precision origin the transformation of the instance is relative to */
+    virtual void setTransformOrigin(const Vec3<double>& origin) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Returns the transformation of the instance */
     virtual AffineSpace3fa getTransform(float time) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -263,6 +291,99 @@ namespace embree
       return numTimeSteps-1;
     }
 
+    /*! returns true if the time steps are spaced uniformly over [0,1] */
+    __forceinline bool hasDefaultTimeSteps () const {
+      return time_steps.empty();
+    }
+
+    /*! returns the time of the i'th time step */
+    __forceinline float timeStep (int i) const 
+    {
+      if (likely(time_steps.empty())) return float(i)/fnumTimeSegments;
+      return time_steps[i];
+    }
+
+    /*! calculates the time segment and the time inside that segment,
+     *  the geometry stays at its first and last time step outside its time range */
+    __forceinline int timeSegment (float time, float& ftime) const
+    {
+      if (likely(time_steps.empty()))
+        return getTimeSegment(time,fnumTimeSegments,ftime);
+      
+      const float t = clamp(time,time_range.lower,time_range.upper);
+      if (uniform_time_steps) {
+        const int itime = getTimeSegment((t-time_range.lower)*rcp_time_range_size,fnumTimeSegments,ftime);
+        ftime = clamp(ftime,0.0f,1.0f);
+        return itime;
+      }
+
+      const int itime = clamp(int(std::upper_bound(time_steps.begin(),time_steps.end(),t)-time_steps.begin())-1,0,int(numTimeSteps)-2);
+      ftime = clamp((t-time_steps[itime])/(time_steps[itime+1]-time_steps[itime]),0.0f,1.0f);
+      return itime;
+    }
+
+    template<int N>
+    __forceinline vint<N> timeSegment (const vfloat<N>& time, vfloat<N>& ftime) const
+    {
+      if (likely(time_steps.empty()))
+        return getTimeSegment(time,vfloat<N>(fnumTimeSegments),ftime);
+
+      vint<N> itime;
+      for (size_t i=0; i<N; i++)
+        itime[i] = timeSegment(time[i],ftime[i]);
+      return itime;
+    }
+
+    /*! calculates the range of time segments overlapping the time range. Parts of
+     *  the time range before or after the time steps count as an additional segment
+     *  at index -1 or numTimeSegments() as the geometry does not move there. */
+    __forceinline range<int> timeSegmentRange (const BBox1f& dt) const
+    {
+      if (likely(time_steps.empty()))
+        return getTimeSegmentRange(dt,fnumTimeSegments);
+
+      const int ilower = dt.lower < time_steps.front() ? -1 : int(std::upper_bound(time_steps.begin(),time_steps.end(),dt.lower)-time_steps.begin())-1;
+      const int iupper = dt.upper > time_steps.back()  ? int(numTimeSteps) : int(std::lower_bound(time_steps.begin(),time_steps.end(),dt.upper)-time_steps.begin());
+      return make_range(ilower,iupper);
+    }
+
+    /*! calculates the range of time steps required for the time range */
+    __forceinline range<int> timeStepRange (const BBox1f& dt) const
+    {
+      const range<int> r = timeSegmentRange(dt);
+      return make_range(max(r.begin(),0),min(r.end(),int(numTimeSteps)-1));
+    }
+
+    /*! calculates linear bounds for the time range from the bounds at each time step */
+    template<typename BoundsFunc>
+    __forceinline LBBox3fa timeLinearBounds (const BoundsFunc& bounds, const BBox1f& dt) const
+    {
+      if (likely(time_steps.empty()))
+        return LBBox3fa(bounds,dt,fnumTimeSegments);
+
+      auto boundsAt = [&] (float time) -> BBox3fa {
+        float ftime; const int itime = timeSegment(time,ftime);
+        return lerp(bounds(itime+0),bounds(itime+1),ftime);
+      };
+
+      /* enlarge linear bounds of the end points by the bounds of the enclosed time steps */
+      BBox3fa b0 = boundsAt(dt.lower);
+      BBox3fa b1 = boundsAt(dt.upper);
+      const range<int> r = timeStepRange(dt);
+      for (int i=r.begin(); i<=r.end(); i++)
+      {
+        if (time_steps[i] <= dt.lower || time_steps[i] >= dt.upper) continue;
+        const float f = (time_steps[i]-dt.lower)/dt.size();
+        const BBox3fa bt = lerp(b0,b1,f);
+        const BBox3fa bi = bounds(i);
+        const Vec3fa dlower = min(bi.lower-bt.lower,Vec3fa(zero));
+        const Vec3fa dupper = max(bi.upper-bt.upper,Vec3fa(zero));
+        b0.lower += dlower; b1.lower += dlower;
+        b0.upper += dupper; b1.upper += dupper;
+      }
+      return LBBox3fa(b0,b1);
+    }
+
   public:
     __forceinline bool hasIntersectionFilter() const { return intersectionFilterN != nullptr; }
     __forceinline bool hasOcclusionFilter() const { return occlusionFilterN != nullptr; }
@@ -276,11 +397,16 @@ namespace embree
     bool numPrimitivesChanged; //!< true if number of primitives changed
     unsigned int numTimeSteps;     //!< number of time steps
     float fnumTimeSegments;    //!< number of time segments (precalculation)
+    BBox1f time_range;         //!< time range covered by the time steps
+    float rcp_time_range_size; //!< reciprocal size of the time range (precalculation)
+    bool uniform_time_steps;   //!< true if time steps are spaced uniformly over the time range
+    std::vector<float> time_steps; //!< time of each time step, empty for uniform time steps over [0,1]
     RTCBuildQuality quality;    //!< build quality for geometry
     bool enabled;              //!< true if geometry is enabled
     State state;
     void* userPtr;             //!< user pointer
     unsigned mask;             //!< for masking out geometry
+    bool backfaceCulling;      //!< true if back faces get culled
     std::atomic<size_t> used;  //!< counts by how many enabled instances this geometry is used
     
   public:
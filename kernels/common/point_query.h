@@ -0,0 +1,79 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "rtcore.h"
+
+namespace embree
+{
+  class Scene;
+
+  /*! Point query for closest point searches, layout compatible to RTCPointQuery. */
+  struct PointQuery
+  {
+    /*! returns the query position */
+    __forceinline Vec3fa p() const {
+      return Vec3fa(x,y,z);
+    }
+
+  public:
+    float x,y,z;  //!< position of the query
+    float time;   //!< time of the query
+    float radius; //!< search radius, shrinks to the distance of the closest point found
+  };
+
+  struct PointQueryContext
+  {
+  public:
+    __forceinline PointQueryContext(Scene* scene, RTCPointQueryResult* result, RTCPointQueryFunction func, void* userPtr)
+      : scene(scene), result(result), func(func), userPtr(userPtr) {}
+
+    /*! records a closer point and shrinks the query radius to its distance */
+    __forceinline void update(PointQuery* query, const float dist, const Vec3fa& p, const float u, const float v, const unsigned geomID, const unsigned primID)
+    {
+      query->radius = dist;
+      result->x = p.x;
+      result->y = p.y;
+      result->z = p.z;
+      result->u = u;
+      result->v = v;
+      result->geomID = geomID;
+      result->primID = primID;
+    }
+
+    /*! invokes the user callback for user geometries and instances */
+    __forceinline bool callback(PointQuery* query, void* geometryUserPtr, const unsigned geomID, const unsigned primID) const
+    {
+      if (func == nullptr) return false;
+      RTCPointQueryFunctionArguments args;
+      args.query = (RTCPointQuery*) query;
+      args.result = result;
+      args.userPtr = userPtr;
+      args.geometryUserPtr = geometryUserPtr;
+      args.geomID = geomID;
+      args.primID = primID;
+      return func(&args);
+    }
+
+  public:
+    Scene* scene;                 //!< scene the query traverses
+    RTCPointQueryResult* result;  //!< closest point found so far
+    RTCPointQueryFunction func;   //!< callback for user geometries and instances
+    void* userPtr;                //!< user pointer passed to the callback
+  };
+}
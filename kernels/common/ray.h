@@ -693,7 +693,7 @@ namespace embree
     }
 
     template<int K>
-    __forceinline void setHitByOffset(const vbool<K>& valid_i, size_t offset, const RayHitK<K>& ray)
+    __forceinline void setHitByOffset(const vbool<K>& valid_i, size_t offset, const RayHitK<K>& ray, bool reduced = false)
     {
       vbool<K> valid = valid_i;
       valid &= (ray.geomID != RTC_INVALID_GEOMETRY_ID);
@@ -701,11 +701,14 @@ namespace embree
       if (likely(any(valid)))
       {
         vfloat<K>::storeu(valid, tfar(offset), ray.tfar);
-        vfloat<K>::storeu(valid, Ng_x(offset), ray.Ng.x);
-        vfloat<K>::storeu(valid, Ng_y(offset), ray.Ng.y);
-        vfloat<K>::storeu(valid, Ng_z(offset), ray.Ng.z);
-        vfloat<K>::storeu(valid, u(offset), ray.u);
-        vfloat<K>::storeu(valid, v(offset), ray.v);
+        if (likely(!reduced))
+        {
+          vfloat<K>::storeu(valid, Ng_x(offset), ray.Ng.x);
+          vfloat<K>::storeu(valid, Ng_y(offset), ray.Ng.y);
+          vfloat<K>::storeu(valid, Ng_z(offset), ray.Ng.z);
+          vfloat<K>::storeu(valid, u(offset), ray.u);
+          vfloat<K>::storeu(valid, v(offset), ray.v);
+        }
 
 #if !defined(__AVX__)
         /* SSE: some ray members must be stored with scalar instructions to ensure that we don't cause memory faults,
@@ -718,7 +721,7 @@ namespace embree
             {
               primID(offset)[k] = ray.primID[k];
               geomID(offset)[k] = ray.geomID[k];
-              instID(offset)[k] = ray.instID[k];
+              if (likely(!reduced)) instID(offset)[k] = ray.instID[k];
             }
           }
         }
@@ -727,7 +730,7 @@ namespace embree
         {
           vint<K>::storeu(valid, primID(offset), ray.primID);
           vint<K>::storeu(valid, geomID(offset), ray.geomID);
-          vint<K>::storeu(valid, instID(offset), ray.instID);
+          if (likely(!reduced)) vint<K>::storeu(valid, instID(offset), ray.instID);
         }
       }
     }
@@ -812,7 +815,7 @@ namespace embree
     }
 
     template<int K>
-    __forceinline void setHitByOffset(const vbool<K>& valid_i, const vint<K>& offset, const RayHitK<K>& ray)
+    __forceinline void setHitByOffset(const vbool<K>& valid_i, const vint<K>& offset, const RayHitK<K>& ray, bool reduced = false)
     {
       vbool<K> valid = valid_i;
       valid &= (ray.geomID != RTC_INVALID_GEOMETRY_ID);
@@ -821,14 +824,17 @@ namespace embree
       {
 #if defined(__AVX512F__)
         vfloat<K>::template scatter<1>(valid, tfar(), offset, ray.tfar);
-        vfloat<K>::template scatter<1>(valid, Ng_x(), offset, ray.Ng.x);
-        vfloat<K>::template scatter<1>(valid, Ng_y(), offset, ray.Ng.y);
-        vfloat<K>::template scatter<1>(valid, Ng_z(), offset, ray.Ng.z);
-        vfloat<K>::template scatter<1>(valid, u(), offset, ray.u);
-        vfloat<K>::template scatter<1>(valid, v(), offset, ray.v);
         vint<K>::template scatter<1>(valid, primID(), offset, ray.primID);
         vint<K>::template scatter<1>(valid, geomID(), offset, ray.geomID);
-        vint<K>::template scatter<1>(valid, instID(), offset, ray.instID);
+        if (likely(!reduced))
+        {
+          vfloat<K>::template scatter<1>(valid, Ng_x(), offset, ray.Ng.x);
+          vfloat<K>::template scatter<1>(valid, Ng_y(), offset, ray.Ng.y);
+          vfloat<K>::template scatter<1>(valid, Ng_z(), offset, ray.Ng.z);
+          vfloat<K>::template scatter<1>(valid, u(), offset, ray.u);
+          vfloat<K>::template scatter<1>(valid, v(), offset, ray.v);
+          vint<K>::template scatter<1>(valid, instID(), offset, ray.instID);
+        }
 #else
         size_t valid_bits = movemask(valid);
         while (valid_bits != 0)
@@ -836,16 +842,18 @@ namespace embree
           const size_t k = __bscf(valid_bits);
           const size_t ofs = offset[k];
 
-          *tfar(ofs) = ray.tfar[k];
-
-          *Ng_x(ofs)   = ray.Ng.x[k];
-          *Ng_y(ofs)   = ray.Ng.y[k];
-          *Ng_z(ofs)   = ray.Ng.z[k];
-          *u(ofs)      = ray.u[k];
-          *v(ofs)      = ray.v[k];
+          *tfar(ofs)   = ray.tfar[k];
           *primID(ofs) = ray.primID[k];
           *geomID(ofs) = ray.geomID[k];
-          *instID(ofs) = ray.instID[k];
+          if (likely(!reduced))
+          {
+            *Ng_x(ofs)   = ray.Ng.x[k];
+            *Ng_y(ofs)   = ray.Ng.y[k];
+            *Ng_z(ofs)   = ray.Ng.z[k];
+            *u(ofs)      = ray.u[k];
+            *v(ofs)      = ray.v[k];
+            *instID(ofs) = ray.instID[k];
+          }
         }
 #endif
       }
@@ -986,7 +994,7 @@ namespace embree
     }
 
     template<int K>
-    __forceinline void setHitByOffset(const vbool<K>& valid_i, size_t offset, const RayHitK<K>& ray)
+    __forceinline void setHitByOffset(const vbool<K>& valid_i, size_t offset, const RayHitK<K>& ray, bool reduced = false)
     {
       vbool<K> valid = valid_i;
       valid &= (ray.geomID != RTC_INVALID_GEOMETRY_ID);
@@ -994,15 +1002,17 @@ namespace embree
       if (likely(any(valid)))
       {
         vfloat<K>::storeu(valid, (float* __restrict__)((char*)tfar + offset), ray.tfar);
-
-        if (likely(Ng_x)) vfloat<K>::storeu(valid, (float* __restrict__)((char*)Ng_x + offset), ray.Ng.x);
-        if (likely(Ng_y)) vfloat<K>::storeu(valid, (float* __restrict__)((char*)Ng_y + offset), ray.Ng.y);
-        if (likely(Ng_z)) vfloat<K>::storeu(valid, (float* __restrict__)((char*)Ng_z + offset), ray.Ng.z);
-        vfloat<K>::storeu(valid, (float* __restrict__)((char*)u + offset), ray.u);
-        vfloat<K>::storeu(valid, (float* __restrict__)((char*)v + offset), ray.v);
         vint<K>::storeu(valid, (int* __restrict__)((char*)primID + offset), ray.primID);
         vint<K>::storeu(valid, (int* __restrict__)((char*)geomID + offset), ray.geomID);
-        if (likely(instID)) vint<K>::storeu(valid, (int* __restrict__)((char*)instID + offset), ray.instID);
+        if (likely(!reduced))
+        {
+          if (likely(Ng_x)) vfloat<K>::storeu(valid, (float* __restrict__)((char*)Ng_x + offset), ray.Ng.x);
+          if (likely(Ng_y)) vfloat<K>::storeu(valid, (float* __restrict__)((char*)Ng_y + offset), ray.Ng.y);
+          if (likely(Ng_z)) vfloat<K>::storeu(valid, (float* __restrict__)((char*)Ng_z + offset), ray.Ng.z);
+          vfloat<K>::storeu(valid, (float* __restrict__)((char*)u + offset), ray.u);
+          vfloat<K>::storeu(valid, (float* __restrict__)((char*)v + offset), ray.v);
+          if (likely(instID)) vint<K>::storeu(valid, (int* __restrict__)((char*)instID + offset), ray.instID);
+        }
       }
     }
 
@@ -1094,7 +1104,7 @@ namespace embree
     }
 
     template<int K>
-    __forceinline void setHitByOffset(const vbool<K>& valid_i, const vint<K>& offset, const RayHitK<K>& ray)
+    __forceinline void setHitByOffset(const vbool<K>& valid_i, const vint<K>& offset, const RayHitK<K>& ray, bool reduced = false)
     {
       vbool<K> valid = valid_i;
       valid &= (ray.geomID != RTC_INVALID_GEOMETRY_ID);
@@ -1103,15 +1113,17 @@ namespace embree
       {
 #if defined(__AVX512F__)
         vfloat<K>::template scatter<1>(valid, tfar, offset, ray.tfar);
-
-        if (likely(Ng_x)) vfloat<K>::template scatter<1>(valid, Ng_x, offset, ray.Ng.x);
-        if (likely(Ng_y)) vfloat<K>::template scatter<1>(valid, Ng_y, offset, ray.Ng.y);
-        if (likely(Ng_z)) vfloat<K>::template scatter<1>(valid, Ng_z, offset, ray.Ng.z);
-        vfloat<K>::template scatter<1>(valid, u, offset, ray.u);
-        vfloat<K>::template scatter<1>(valid, v, offset, ray.v);
         vint<K>::template scatter<1>(valid, (int*)geomID, offset, ray.geomID);
         vint<K>::template scatter<1>(valid, (int*)primID, offset, ray.primID);
-        if (likely(instID)) vint<K>::template scatter<1>(valid, (int*)instID, offset, ray.instID);
+        if (likely(!reduced))
+        {
+          if (likely(Ng_x)) vfloat<K>::template scatter<1>(valid, Ng_x, offset, ray.Ng.x);
+          if (likely(Ng_y)) vfloat<K>::template scatter<1>(valid, Ng_y, offset, ray.Ng.y);
+          if (likely(Ng_z)) vfloat<K>::template scatter<1>(valid, Ng_z, offset, ray.Ng.z);
+          vfloat<K>::template scatter<1>(valid, u, offset, ray.u);
+          vfloat<K>::template scatter<1>(valid, v, offset, ray.v);
+          if (likely(instID)) vint<K>::template scatter<1>(valid, (int*)instID, offset, ray.instID);
+        }
 #else
         size_t valid_bits = movemask(valid);
         while (valid_bits != 0)
@@ -1120,15 +1132,17 @@ namespace embree
           const size_t ofs = offset[k];
 
           *(float* __restrict__)((char*)tfar + ofs) = ray.tfar[k];
-
-          if (likely(Ng_x)) *(float* __restrict__)((char*)Ng_x + ofs) = ray.Ng.x[k];
-          if (likely(Ng_y)) *(float* __restrict__)((char*)Ng_y + ofs) = ray.Ng.y[k];
-          if (likely(Ng_z)) *(float* __restrict__)((char*)Ng_z + ofs) = ray.Ng.z[k];
-          *(float* __restrict__)((char*)u + ofs) = ray.u[k];
-          *(float* __restrict__)((char*)v + ofs) = ray.v[k];
           *(unsigned int* __restrict__)((char*)primID + ofs) = ray.primID[k];
           *(unsigned int* __restrict__)((char*)geomID + ofs) = ray.geomID[k];
-          if (likely(instID)) *(unsigned int* __restrict__)((char*)instID + ofs) = ray.instID[k];
+          if (likely(!reduced))
+          {
+            if (likely(Ng_x)) *(float* __restrict__)((char*)Ng_x + ofs) = ray.Ng.x[k];
+            if (likely(Ng_y)) *(float* __restrict__)((char*)Ng_y + ofs) = ray.Ng.y[k];
+            if (likely(Ng_z)) *(float* __restrict__)((char*)Ng_z + ofs) = ray.Ng.z[k];
+            *(float* __restrict__)((char*)u + ofs) = ray.u[k];
+            *(float* __restrict__)((char*)v + ofs) = ray.v[k];
+            if (likely(instID)) *(unsigned int* __restrict__)((char*)instID + ofs) = ray.instID[k];
+          }
         }
 #endif
       }
@@ -1208,7 +1222,7 @@ namespace embree
     }
 
     template<int K>
-    __forceinline void setHitByOffset(const vbool<K>& valid_i, const vint<K>& offset, const RayHitK<K>& ray)
+    __forceinline void setHitByOffset(const vbool<K>& valid_i, const vint<K>& offset, const RayHitK<K>& ray, bool reduced = false)
     {
       vbool<K> valid = valid_i;
       valid &= (ray.geomID != RTC_INVALID_GEOMETRY_ID);
@@ -1217,14 +1231,17 @@ namespace embree
       {
 #if defined(__AVX512F__)
         vfloat<K>::template scatter<1>(valid, &ptr->tfar, offset, ray.tfar);
-        vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->Ng.x, offset, ray.Ng.x);
-        vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->Ng.y, offset, ray.Ng.y);
-        vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->Ng.z, offset, ray.Ng.z);
-        vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->u, offset, ray.u);
-        vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->v, offset, ray.v);
         vint<K>::template scatter<1>(valid, (int*)&((RayHit*)ptr)->primID, offset, ray.primID);
         vint<K>::template scatter<1>(valid, (int*)&((RayHit*)ptr)->geomID, offset, ray.geomID);
-        vint<K>::template scatter<1>(valid, (int*)&((RayHit*)ptr)->instID, offset, ray.instID);
+        if (likely(!reduced))
+        {
+          vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->Ng.x, offset, ray.Ng.x);
+          vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->Ng.y, offset, ray.Ng.y);
+          vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->Ng.z, offset, ray.Ng.z);
+          vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->u, offset, ray.u);
+          vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->v, offset, ray.v);
+          vint<K>::template scatter<1>(valid, (int*)&((RayHit*)ptr)->instID, offset, ray.instID);
+        }
 #else
         size_t valid_bits = movemask(valid);
         while (valid_bits != 0)
@@ -1232,14 +1249,17 @@ namespace embree
           const size_t k = __bscf(valid_bits);
           RayHit* __restrict__ ray_k = (RayHit*)((char*)ptr + offset[k]);
           ray_k->tfar   = ray.tfar[k];
-          ray_k->Ng.x   = ray.Ng.x[k];
-          ray_k->Ng.y   = ray.Ng.y[k];
-          ray_k->Ng.z   = ray.Ng.z[k];
-          ray_k->u      = ray.u[k];
-          ray_k->v      = ray.v[k];
           ray_k->primID = ray.primID[k];
           ray_k->geomID = ray.geomID[k];
-          ray_k->instID = ray.instID[k];
+          if (likely(!reduced))
+          {
+            ray_k->Ng.x   = ray.Ng.x[k];
+            ray_k->Ng.y   = ray.Ng.y[k];
+            ray_k->Ng.z   = ray.Ng.z[k];
+            ray_k->u      = ray.u[k];
+            ray_k->v      = ray.v[k];
+            ray_k->instID = ray.instID[k];
+          }
         }
 #endif
       }
@@ -1422,7 +1442,7 @@ namespace embree
     }
 
     template<int K>
-    __forceinline void setHitByIndex(const vbool<K>& valid_i, const vint<K>& index, const RayHitK<K>& ray)
+    __forceinline void setHitByIndex(const vbool<K>& valid_i, const vint<K>& index, const RayHitK<K>& ray, bool reduced = false)
     {
       vbool<K> valid = valid_i;
       valid &= (ray.geomID != RTC_INVALID_GEOMETRY_ID);
@@ -1435,15 +1455,18 @@ namespace embree
           const size_t k = __bscf(valid_bits);
           RayHit* __restrict__ ray_k = (RayHit*)ptr[index[k]];
 
-          ray_k->tfar = ray.tfar[k];
-          ray_k->Ng.x   = ray.Ng.x[k];
-          ray_k->Ng.y   = ray.Ng.y[k];
-          ray_k->Ng.z   = ray.Ng.z[k];
-          ray_k->u      = ray.u[k];
-          ray_k->v      = ray.v[k];
+          ray_k->tfar   = ray.tfar[k];
           ray_k->primID = ray.primID[k];
           ray_k->geomID = ray.geomID[k];
-          ray_k->instID = ray.instID[k];
+          if (likely(!reduced))
+          {
+            ray_k->Ng.x   = ray.Ng.x[k];
+            ray_k->Ng.y   = ray.Ng.y[k];
+            ray_k->Ng.z   = ray.Ng.z[k];
+            ray_k->u      = ray.u[k];
+            ray_k->v      = ray.v[k];
+            ray_k->instID = ray.instID[k];
+          }
         }
       }
     }
@@ -106,6 +106,45 @@ namespace embree
     RTC_CATCH_END(device);
   }
 
+  RTC_API void rtcSetDeviceAllocator(RTCDevice hdevice, RTCAllocFunction alloc, RTCFreeFunction free, RTCShrinkFunction shrink, void* userPtr)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetDeviceAllocator);
+    RTC_VERIFY_HANDLE(hdevice);
+    Lock<MutexSys> lock(g_mutex);
+    device->setAllocator(alloc, free, shrink, userPtr);
+    RTC_CATCH_END(device);
+  }
+
+  RTC_API void rtcJoinDeviceThreadPool(RTCDevice hdevice)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcJoinDeviceThreadPool);
+    RTC_VERIFY_HANDLE(hdevice);
+#if defined(TASKING_INTERNAL)
+    TaskScheduler::joinThreadPool(device->joinedThreads);
+#else
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"joining the thread pool is only supported by the internal tasking system");
+#endif
+    RTC_CATCH_END(device);
+  }
+
+  RTC_API void rtcLeaveDeviceThreadPool(RTCDevice hdevice)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcLeaveDeviceThreadPool);
+    RTC_VERIFY_HANDLE(hdevice);
+#if defined(TASKING_INTERNAL)
+    TaskScheduler::leaveThreadPool(device->joinedThreads);
+#else
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"joining the thread pool is only supported by the internal tasking system");
+#endif
+    RTC_CATCH_END(device);
+  }
+
   RTC_API RTCBuffer rtcNewBuffer(RTCDevice hdevice, size_t byteSize)
   {
     RTC_CATCH_BEGIN;
@@ -194,6 +233,30 @@ namespace embree
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcSetSceneBuildPriority (RTCScene hscene, RTCBuildPriority priority) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneBuildPriority);
+    RTC_VERIFY_HANDLE(hscene);
+    if (priority != RTC_BUILD_PRIORITY_LOW &&
+        priority != RTC_BUILD_PRIORITY_MEDIUM &&
+        priority != RTC_BUILD_PRIORITY_HIGH)
+      throw std::runtime_error("invalid build priority");
+    scene->setBuildPriority(priority);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcSetSceneBuildThreadCount (RTCScene hscene, unsigned int threadCount) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneBuildThreadCount);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->setBuildThreadCount(threadCount);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcSetSceneFlags (RTCScene hscene, RTCSceneFlags flags) 
   {
     Scene* scene = (Scene*) hscene;
@@ -204,6 +267,18 @@ namespace embree
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcSetSceneTimeRange (RTCScene hscene, float startTime, float endTime) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneTimeRange);
+    RTC_VERIFY_HANDLE(hscene);
+    if (!(0.0f <= startTime && startTime < endTime && endTime <= 1.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid time range");
+    scene->setTimeRange(BBox1f(startTime,endTime));
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API RTCSceneFlags rtcGetSceneFlags(RTCScene hscene)
   {
     Scene* scene = (Scene*) hscene;
@@ -235,6 +310,74 @@ namespace embree
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcCancelCommitScene (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCancelCommitScene);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->cancelCommit();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API RTCCommit rtcCommitSceneAsync (RTCScene hscene, RTCCommitCompletionFunction completion, void* ptr) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitSceneAsync);
+    RTC_VERIFY_HANDLE(hscene);
+    AsyncCommit* commit = new AsyncCommit(scene,completion,ptr);
+    return (RTCCommit) commit->refInc();
+    RTC_CATCH_END2(scene);
+    return nullptr;
+  }
+
+  RTC_API bool rtcIsCommitDone (RTCCommit hcommit) 
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIsCommitDone);
+    RTC_VERIFY_HANDLE(hcommit);
+    return commit->isDone();
+    RTC_CATCH_END2(scene);
+    return false;
+  }
+
+  RTC_API RTCError rtcWaitCommit (RTCCommit hcommit) 
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcWaitCommit);
+    RTC_VERIFY_HANDLE(hcommit);
+    return commit->wait();
+    RTC_CATCH_END2(scene);
+    return RTC_ERROR_UNKNOWN;
+  }
+
+  RTC_API void rtcRetainCommit (RTCCommit hcommit) 
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcRetainCommit);
+    RTC_VERIFY_HANDLE(hcommit);
+    commit->refInc();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcReleaseCommit (RTCCommit hcommit) 
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcReleaseCommit);
+    RTC_VERIFY_HANDLE(hcommit);
+    commit->refDec();
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -291,10 +434,11 @@ namespace embree
     RTC_TRACE(rtcIntersect1);
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     STAT3(normal.travs,1,1,1);
+    QueryStatistics stats(user_context,false,1);
     IntersectContext context(scene,user_context);
     scene->intersectors.intersect(*rayhit,&context);
 #if defined(DEBUG)
@@ -311,12 +455,13 @@ namespace embree
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)rayhit)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,cnt,cnt,cnt);
+    QueryStatistics stats(user_context,false,valid,4);
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -342,12 +487,13 @@ namespace embree
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)rayhit)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 32 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,cnt,cnt,cnt);
+    QueryStatistics stats(user_context,false,valid,8);
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -375,12 +521,13 @@ namespace embree
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)rayhit)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 64 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,cnt,cnt,cnt);
+    QueryStatistics stats(user_context,false,valid,16);
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -409,10 +556,11 @@ namespace embree
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rayhit ) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,M,M);
+    QueryStatistics stats(user_context,false,M);
     IntersectContext context(scene,user_context);
 
     /* fast codepath for single rays */
@@ -440,10 +588,11 @@ namespace embree
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rn) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,M,M);
+    QueryStatistics stats(user_context,false,M);
     IntersectContext context(scene,user_context);
 
     /* fast codepath for single rays */
@@ -471,10 +620,11 @@ namespace embree
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rayhit) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N*M,N*M,N*M);
+    QueryStatistics stats(user_context,false,N*M);
     IntersectContext context(scene,user_context);
 
     /* code path for single ray streams */
@@ -509,7 +659,7 @@ namespace embree
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rayhit->ray.org_x ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_x not aligned to 4 bytes");   
     if (((size_t)rayhit->ray.org_y ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_y not aligned to 4 bytes");   
     if (((size_t)rayhit->ray.org_z ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_z not aligned to 4 bytes");   
@@ -530,6 +680,7 @@ namespace embree
     if (((size_t)rayhit->hit.instID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.instID not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N,N,N);
+    QueryStatistics stats(user_context,false,N);
     IntersectContext context(scene,user_context);
     scene->device->rayStreamFilters.intersectSOP(scene,rayhit,N,&context);
 #else
@@ -544,9 +695,10 @@ namespace embree
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcOccluded1);
     STAT3(shadow.travs,1,1,1);
+    QueryStatistics stats(user_context,true,1);
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     IntersectContext context(scene,user_context);
@@ -562,12 +714,13 @@ namespace embree
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)ray)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,cnt,cnt,cnt);
+    QueryStatistics stats(user_context,true,valid,4);
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -593,12 +746,13 @@ namespace embree
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)ray)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 32 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,cnt,cnt,cnt);
+    QueryStatistics stats(user_context,true,valid,8);
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -627,12 +781,13 @@ namespace embree
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)ray)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 64 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,cnt,cnt,cnt);
+    QueryStatistics stats(user_context,true,valid,16);
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -662,10 +817,11 @@ namespace embree
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,M,M);
+    QueryStatistics stats(user_context,true,M);
     IntersectContext context(scene,user_context);
     /* fast codepath for streams of size 1 */
     if (likely(M == 1)) {
@@ -691,10 +847,11 @@ namespace embree
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,M,M);
+    QueryStatistics stats(user_context,true,M);
     IntersectContext context(scene,user_context);
 
     /* fast codepath for streams of size 1 */
@@ -722,10 +879,11 @@ namespace embree
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
     if (byteStride < sizeof(RTCRayHit)) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"byteStride too small");
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,N*M,N*N,N*N);
+    QueryStatistics stats(user_context,true,N*M);
     IntersectContext context(scene,user_context);
 
     /* codepath for single rays */
@@ -760,7 +918,7 @@ namespace embree
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)ray->org_x ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_x not aligned to 4 bytes");   
     if (((size_t)ray->org_y ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_y not aligned to 4 bytes");   
     if (((size_t)ray->org_z ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_z not aligned to 4 bytes");   
@@ -781,6 +939,7 @@ namespace embree
     // if (((size_t)ray->hit.instID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "instID not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,N,N,N);
+    QueryStatistics stats(user_context,true,N);
     IntersectContext context(scene,user_context);
     scene->device->rayStreamFilters.occludedSOP(scene,ray,N,&context);
 #else
@@ -789,6 +948,26 @@ namespace embree
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API bool rtcPointQuery(RTCScene hscene, RTCPointQuery* query, RTCPointQueryResult* result, RTCPointQueryFunction queryFunc, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQuery);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraceable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query ) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+    if (((size_t)result) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "result not aligned to 16 bytes");
+#endif
+    result->geomID = RTC_INVALID_GEOMETRY_ID;
+    result->primID = RTC_INVALID_GEOMETRY_ID;
+    PointQueryContext context(scene,result,queryFunc,userPtr);
+    scene->intersectors.pointQuery((PointQuery*)query,&context);
+    return result->geomID != RTC_INVALID_GEOMETRY_ID;
+    RTC_CATCH_END2(scene);
+    return false;
+  }
+
   RTC_API void rtcRetainScene (RTCScene hscene) 
   {
     Scene* scene = (Scene*) hscene;
@@ -949,8 +1128,25 @@ namespace embree
     RTC_TRACE(rtcSetGeometryTransform);
     RTC_VERIFY_HANDLE(hgeometry);
     RTC_VERIFY_HANDLE(xfm);
-    const AffineSpace3fa transform = loadTransform(format, (const float*)xfm);
-    geometry->setTransform(transform, timeStep);
+    if (format == RTC_FORMAT_QUATERNION_DECOMPOSITION) {
+      const RTCQuaternionDecomposition* qd = (const RTCQuaternionDecomposition*) xfm;
+      geometry->setQuaternionDecomposition(QuaternionDecomposition(Vec3fa(qd->scale_x,qd->scale_y,qd->scale_z),
+                                                                   Quaternion3f(qd->quaternion_r,qd->quaternion_i,qd->quaternion_j,qd->quaternion_k),
+                                                                   Vec3fa(qd->translation_x,qd->translation_y,qd->translation_z)),timeStep);
+    } else {
+      const AffineSpace3fa transform = loadTransform(format, (const float*)xfm);
+      geometry->setTransform(transform, timeStep);
+    }
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryTransformOrigin(RTCGeometry hgeometry, double x, double y, double z)
+  {
+    Ref<Geometry> geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTransformOrigin);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setTransformOrigin(Vec3<double>(x,y,z));
     RTC_CATCH_END2(geometry);
   }
 
@@ -1106,6 +1302,26 @@ namespace embree
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTimeRange(RTCGeometry hgeometry, float startTime, float endTime)
+  {
+    Ref<Geometry> geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTimeRange);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setTimeRange(BBox1f(startTime,endTime));
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryTimeSteps(RTCGeometry hgeometry, const float* times)
+  {
+    Ref<Geometry> geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTimeSteps);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setTimeSteps(times);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry hgeometry, unsigned int N)
   {
     Ref<Geometry> geometry = (Geometry*) hgeometry;
@@ -1152,6 +1368,16 @@ namespace embree
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryBackfaceCulling (RTCGeometry hgeometry, bool enable) 
+  {
+    Ref<Geometry> geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryBackfaceCulling);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setBackfaceCulling(enable);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometrySubdivisionMode (RTCGeometry hgeometry, unsigned topologyID, RTCSubdivisionMode mode) 
   {
     Ref<Geometry> geometry = (Geometry*) hgeometry;
@@ -35,11 +35,17 @@ namespace embree
       flags_modified(true),
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
+      time_range(0.0f,1.0f),
+      build_priority(RTC_BUILD_PRIORITY_MEDIUM), build_thread_count(0),
+      commitGeneration(0), buildGeneration(0), cancelGeneration(0),
       is_build(false), modified(true),
+      frontAccels(nullptr), epoch(0),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
-      numIntersectionFiltersN(0)
+      numIntersectionFiltersN(0), numBackfaceCullingGeometries(0)
   {
     device->refInc();
+    epochReaders[0] = 0;
+    epochReaders[1] = 0;
     
 #if defined(TASKING_INTERNAL) 
     scheduler = nullptr;
@@ -64,6 +70,8 @@ namespace embree
     delete group; group = nullptr;
 #endif
 
+    delete frontAccels.load();
+
     /* detach all geometries */
     for (auto& geometry : geometries)
       if (geometry)
@@ -135,6 +143,17 @@ namespace embree
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
         switch (mode) {
         case /*0b00*/ 0: 
+          if (isWatertightAccel())
+          {
+            const BVHFactory::BuildVariant bvariant = quality_flags == RTC_BUILD_QUALITY_HIGH ? BVHFactory::BuildVariant::HIGH_QUALITY : BVHFactory::BuildVariant::STATIC;
+#if defined (EMBREE_TARGET_SIMD8)
+            if (device->hasISA(AVX))
+              accels.add(device->bvh8_factory->BVH8Triangle4v(this,bvariant,BVHFactory::IntersectVariant::WATERTIGHT));
+            else
+#endif
+              accels.add(device->bvh4_factory->BVH4Triangle4v(this,bvariant,BVHFactory::IntersectVariant::WATERTIGHT));
+            break;
+          }
 #if defined (EMBREE_TARGET_SIMD8)
           if (device->hasISA(AVX))
 	  {
@@ -162,7 +181,7 @@ namespace embree
             accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
 
           break;
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,isWatertightAccel() ? BVHFactory::IntersectVariant::WATERTIGHT : BVHFactory::IntersectVariant::FAST)); break;
         case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -173,9 +192,12 @@ namespace embree
 	  {
             int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel();
             switch (mode) {
-            case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Triangle4 (this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
+            case /*0b00*/ 0:
+              if (isWatertightAccel()) accels.add(device->bvh8_factory->BVH8Triangle4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::WATERTIGHT));
+              else                     accels.add(device->bvh8_factory->BVH8Triangle4 (this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  ));
+              break;
             case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8Triangle4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
+            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,isWatertightAccel() ? BVHFactory::IntersectVariant::WATERTIGHT : BVHFactory::IntersectVariant::FAST)); break;
             case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
             }
           }
@@ -184,9 +206,12 @@ namespace embree
           {
             int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel();
             switch (mode) {
-            case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Triangle4 (this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
+            case /*0b00*/ 0:
+              if (isWatertightAccel()) accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::WATERTIGHT));
+              else                     accels.add(device->bvh4_factory->BVH4Triangle4 (this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  ));
+              break;
             case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
+            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,isWatertightAccel() ? BVHFactory::IntersectVariant::WATERTIGHT : BVHFactory::IntersectVariant::FAST)); break;
             case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
             }
           }
@@ -213,15 +238,16 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_TRIANGLES)
     if (device->tri_accel_mb == "default")
     {
+      const BVHFactory::IntersectVariant fast = isWatertightAccel() ? BVHFactory::IntersectVariant::WATERTIGHT : BVHFactory::IntersectVariant::FAST;
       int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
       
 #if defined (EMBREE_TARGET_SIMD8)
       if (device->hasISA(AVX2)) // BVH8 reduces performance on AVX only-machines
       {
         switch (mode) {
-        case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+        case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,fast)); break;
         case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,fast)); break;
         case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -229,9 +255,9 @@ namespace embree
 #endif
       {
         switch (mode) {
-        case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+        case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,fast)); break;
         case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,fast)); break;
         case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -251,6 +277,7 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_QUADS)
     if (device->quad_accel == "default") 
     {
+      const BVHFactory::IntersectVariant fast = isWatertightAccel() ? BVHFactory::IntersectVariant::WATERTIGHT : BVHFactory::IntersectVariant::FAST;
       if (quality_flags != RTC_BUILD_QUALITY_LOW)
       {
         /* static */
@@ -261,17 +288,17 @@ namespace embree
           if (device->hasISA(AVX))
           {
             if (quality_flags == RTC_BUILD_QUALITY_HIGH) 
-              accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST));
+              accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::HIGH_QUALITY,fast));
             else
-              accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST));
+              accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::STATIC,fast));
           }
           else
 #endif
           {
             if (quality_flags == RTC_BUILD_QUALITY_HIGH) 
-              accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST));
+              accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::HIGH_QUALITY,fast));
             else
-              accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST));
+              accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::STATIC,fast));
           }
           break;
 
@@ -284,7 +311,7 @@ namespace embree
             accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
           break;
 
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST)); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVHFactory::BuildVariant::STATIC,fast)); break;
         case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -295,9 +322,9 @@ namespace embree
 	  {
             int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel();
             switch (mode) {
-            case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
+            case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,fast)); break;
             case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
+            case /*0b10*/ 2: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,fast)); break;
             case /*0b11*/ 3: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
             }
           }
@@ -306,9 +333,9 @@ namespace embree
           {
             int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel();
             switch (mode) {
-            case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
+            case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,fast)); break;
             case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
+            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,fast)); break;
             case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
             }
           }
@@ -332,15 +359,16 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_QUADS)
     if (device->quad_accel_mb == "default") 
     {
+      const BVHFactory::IntersectVariant fast = isWatertightAccel() ? BVHFactory::IntersectVariant::WATERTIGHT : BVHFactory::IntersectVariant::FAST;
       int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
       switch (mode) {
       case /*0b00*/ 0:
 #if defined (EMBREE_TARGET_SIMD8)
         if (device->hasISA(AVX))
-          accels.add(device->bvh8_factory->BVH8Quad4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST));
+          accels.add(device->bvh8_factory->BVH8Quad4iMB(this,BVHFactory::BuildVariant::STATIC,fast));
         else
 #endif
-          accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST));
+          accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVHFactory::BuildVariant::STATIC,fast));
         break;
 
       case /*0b01*/ 1:
@@ -352,7 +380,7 @@ namespace embree
           accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
         break;
 
-      case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+      case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVHFactory::BuildVariant::STATIC,fast)); break;
       case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
       }
     }
@@ -617,10 +645,108 @@ namespace embree
   {
     /* update bounds */
     is_build = true;
+
+    /* double buffered scenes trace the front acceleration structures */
+    if (AccelN* front = frontAccels)
+    {
+      bounds = front->bounds;
+      if (intersectors.ptr != this)
+      {
+        Accel::Intersectors frontIntersectors;
+        frontIntersectors.ptr = this;
+        frontIntersectors.intersector1  = Intersector1(&intersectFront,&occludedFront,&pointQueryFront,"Scene::intersectorFront1");
+        frontIntersectors.intersector4  = Intersector4(&intersectFront4,&occludedFront4,"Scene::intersectorFront4");
+        frontIntersectors.intersector8  = Intersector8(&intersectFront8,&occludedFront8,"Scene::intersectorFront8");
+        frontIntersectors.intersector16 = Intersector16(&intersectFront16,&occludedFront16,"Scene::intersectorFront16");
+        frontIntersectors.intersectorN  = IntersectorN(&intersectFrontN,&occludedFrontN,"Scene::intersectorFrontN");
+        intersectors = frontIntersectors;
+      }
+      return;
+    }
+    
     bounds = accels.bounds;
     intersectors = accels.intersectors;
   }
 
+  void Scene::swapFrontAccels(AccelN* front)
+  {
+    AccelN* old = frontAccels.exchange(front);
+    if (old == nullptr) return;
+
+    /* queries that enter a new epoch see the new front, wait for all queries of the previous epoch */
+    const size_t slot = epoch++ & 1;
+    while (epochReaders[slot] != 0)
+      __pause_cpu();
+    
+    delete old;
+  }
+
+  void Scene::intersectFront (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.intersect(ray,context);
+  }
+
+  void Scene::intersectFront4 (const void* valid, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.intersect4(valid,ray,context);
+  }
+
+  void Scene::intersectFront8 (const void* valid, Accel::Intersectors* This, RTCRayHit8& ray, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.intersect8(valid,ray,context);
+  }
+
+  void Scene::intersectFront16 (const void* valid, Accel::Intersectors* This, RTCRayHit16& ray, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.intersect16(valid,ray,context);
+  }
+
+  void Scene::intersectFrontN (Accel::Intersectors* This, RayHitK<VSIZEX>** ray, const size_t N, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.intersectN(ray,N,context);
+  }
+
+  void Scene::occludedFront (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.occluded(ray,context);
+  }
+
+  void Scene::occludedFront4 (const void* valid, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.occluded4(valid,ray,context);
+  }
+
+  void Scene::occludedFront8 (const void* valid, Accel::Intersectors* This, RTCRay8& ray, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.occluded8(valid,ray,context);
+  }
+
+  void Scene::occludedFront16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.occluded16(valid,ray,context);
+  }
+
+  void Scene::occludedFrontN (Accel::Intersectors* This, RayK<VSIZEX>** ray, const size_t N, IntersectContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    guard.accels->intersectors.occludedN(ray,N,context);
+  }
+
+  bool Scene::pointQueryFront (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context)
+  {
+    EpochGuard guard((Scene*)This->ptr);
+    return guard.accels->intersectors.pointQuery(query,context);
+  }
+
   void Scene::commit_task ()
   {
     /* print scene statistics */
@@ -672,6 +798,14 @@ namespace embree
       flags_modified = true; // in non-dynamic mode we have to re-create accels
     }
 
+    /* double buffered scenes trace the new acceleration structures from now on and build the next ones into new memory */
+    if (isDoubleBufferedAccel()) {
+      swapFrontAccels(accels.detach());
+      flags_modified = true;
+    }
+    else
+      swapFrontAccels(nullptr);
+
     /* call postCommit function of each geometry */
     parallel_for(geometries.size(), [&] ( const size_t i ) {
         if (geometries[i] && geometries[i]->isEnabled())
@@ -711,10 +845,40 @@ namespace embree
   RTCSceneFlags Scene::getSceneFlags() const {
     return scene_flags;
   }
+
+  void Scene::setTimeRange(const BBox1f& time_range_i)
+  {
+    if (time_range.lower == time_range_i.lower && time_range.upper == time_range_i.upper) return;
+    time_range = time_range_i;
+    setModified();
+  }
+
+  void Scene::setBuildPriority(RTCBuildPriority priority) {
+    build_priority = priority;
+  }
+
+  void Scene::setBuildThreadCount(size_t threadCount) {
+    build_thread_count = threadCount;
+  }
+
+  void Scene::cancelCommit()
+  {
+    /* the cancel sticks to the requested commit, even if its build did not start yet */
+#if defined(TASKING_INTERNAL)
+    Lock<MutexSys> lock(schedulerMutex);
+#endif
+    cancelGeneration = commitGeneration.load();
+
+    /* tasks that did not start yet get skipped */
+#if defined(TASKING_INTERNAL)
+    if (scheduler && buildGeneration == cancelGeneration)
+      scheduler->cancel(std::make_exception_ptr(rtcore_error(RTC_ERROR_CANCELLED,"commit cancelled")));
+#endif
+  }
                    
 #if defined(TASKING_INTERNAL)
 
-  void Scene::commit (bool join) 
+  void Scene::commit (bool join, size_t generation) 
   {
     Lock<MutexSys> buildLock(buildMutex,false);
 
@@ -726,6 +890,11 @@ namespace embree
       if (scheduler == null) {
         buildLock.lock();
         this->scheduler = scheduler = new TaskScheduler;
+        scheduler->setPriority(build_priority);
+        scheduler->setMaxThreads(build_thread_count);
+        buildGeneration = generation ? generation : requestCommit();
+        if (buildGeneration == cancelGeneration)
+          scheduler->cancel(std::make_exception_ptr(rtcore_error(RTC_ERROR_CANCELLED,"commit cancelled")));
       }
     }
 
@@ -741,7 +910,14 @@ namespace embree
 
     /* fast path for unchanged scenes */
     if (!isModified()) {
-      scheduler->spawn_root([&]() { Lock<MutexSys> lock(schedulerMutex); this->scheduler = nullptr; }, 1, !join);
+      try {
+        scheduler->spawn_root([&]() { Lock<MutexSys> lock(schedulerMutex); this->scheduler = nullptr; }, 1, !join);
+      }
+      catch (...) {
+        Lock<MutexSys> lock(schedulerMutex);
+        this->scheduler = nullptr;
+        throw;
+      }
       return;
     }
 
@@ -762,7 +938,7 @@ namespace embree
 
 #if defined(TASKING_TBB) || defined(TASKING_PPL)
 
-  void Scene::commit (bool join) 
+  void Scene::commit (bool join, size_t generation) 
   {
 #if defined(TASKING_PPL)
     if (join)
@@ -776,6 +952,7 @@ namespace embree
 
     /* try to obtain build lock */
     Lock<MutexSys> lock(buildMutex,buildMutex.try_lock());
+    if (lock.isLocked()) buildGeneration = generation ? generation : requestCommit();
 
     /* join hierarchy build */
     if (!lock.isLocked())
@@ -862,6 +1039,9 @@ namespace embree
 
   void Scene::progressMonitor(double dn)
   {
+    if (unlikely(buildGeneration == cancelGeneration))
+      throw_RTCError(RTC_ERROR_CANCELLED,"commit cancelled");
+
     if (progress_monitor_function) {
       size_t n = size_t(dn) + progress_monitor_counter.fetch_add(size_t(dn));
       if (!progress_monitor_function(progress_monitor_ptr, n / (double(numPrimitives())))) {
@@ -869,4 +1049,67 @@ namespace embree
       }
     }
   }
+
+  /*! asynchronous commit executed by the calling thread */
+  static __thread AsyncCommit* g_async_commit = nullptr;
+
+  AsyncCommit::AsyncCommit (Scene* scene, RTCCommitCompletionFunction completion, void* ptr)
+    : scene(scene), generation(scene->requestCommit()), completion(completion), ptr(ptr), thread(nullptr), done(false), error(RTC_ERROR_NONE)
+  {
+    thread = createThread(run,this);
+  }
+
+  AsyncCommit::~AsyncCommit ()
+  {
+    /* the completion function released the last reference, the commit thread cannot join itself */
+    if (g_async_commit == this) {
+      detachThread(thread);
+      return;
+    }
+    wait();
+  }
+
+  RTCError AsyncCommit::wait()
+  {
+    /* called from the completion function, the commit finished already */
+    if (g_async_commit == this)
+      return error;
+
+    Lock<MutexSys> lock(mutex);
+    if (thread) {
+      join(thread);
+      thread = nullptr;
+    }
+    return error;
+  }
+
+  void AsyncCommit::run(void* ptr)
+  {
+    AsyncCommit* commit = (AsyncCommit*) ptr;
+    Scene* scene = commit->scene.ptr;
+    g_async_commit = commit;
+    
+    try {
+      scene->commit(false,commit->generation);
+    } catch (std::bad_alloc&) {
+      commit->error = RTC_ERROR_OUT_OF_MEMORY;
+      Device::process_error(scene->device,RTC_ERROR_OUT_OF_MEMORY,"out of memory");
+    } catch (rtcore_error& e) {
+      commit->error = e.error;
+      Device::process_error(scene->device,e.error,e.what());
+    } catch (std::exception& e) {
+      commit->error = RTC_ERROR_UNKNOWN;
+      Device::process_error(scene->device,RTC_ERROR_UNKNOWN,e.what());
+    } catch (...) {
+      commit->error = RTC_ERROR_UNKNOWN;
+      Device::process_error(scene->device,RTC_ERROR_UNKNOWN,"unknown exception caught");
+    }
+
+    commit->done = true;
+
+    /* the completion function may release the commit */
+    if (commit->completion)
+      commit->completion(commit->ptr,(RTCScene)scene,commit->error);
+    g_async_commit = nullptr;
+  }
 }
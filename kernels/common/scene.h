@@ -92,6 +92,16 @@ namespace embree
         }
         return ret;
       }
+
+      __forceinline bool allDefaultTimeSteps()
+      {
+        for (size_t i=0; i<scene->size(); i++) {
+          Ty* mesh = at(i);
+          if (mesh == nullptr) continue;
+          if (!mesh->hasDefaultTimeSteps()) return false;
+        }
+        return true;
+      }
       
     private:
       Scene* scene;
@@ -139,13 +149,31 @@ namespace embree
     
     void setSceneFlags(RTCSceneFlags scene_flags);
     RTCSceneFlags getSceneFlags() const;
+
+    void setTimeRange(const BBox1f& time_range);
+
+    /*! sets the build priority and maximal number of build threads, only the internal tasking system supports them */
+    void setBuildPriority(RTCBuildPriority priority);
+    void setBuildThreadCount(size_t threadCount);
+
+    /*! cancels the most recently requested commit, also if its build did not start yet */
+    void cancelCommit();
+
+    /*! requests a new commit and returns its generation */
+    size_t requestCommit() { return ++commitGeneration; }
+
+    /* returns true if motion blur accels get only build for part of the time range */
+    __forceinline bool hasPartialTimeRange() const { return time_range.lower != 0.0f || time_range.upper != 1.0f; }
     
-    void commit (bool join);
+    void commit (bool join, size_t generation = 0);
     void commit_task ();
     void build () {}
 
     void updateInterface();
 
+    /*! publishes new front acceleration structures and frees the old ones once no query traces them anymore */
+    void swapFrontAccels(AccelN* front);
+
     /* return number of geometries */
     __forceinline size_t size() const { return geometries.size(); }
     
@@ -155,6 +183,9 @@ namespace embree
     /* determines if scene is modified */
     __forceinline bool isModified() const { return modified; }
 
+    /* determines if the scene can get traced, double buffered scenes stay traceable while they get modified or committed */
+    __forceinline bool isTraceable() const { return !modified || frontAccels.load() != nullptr; }
+
     /* sets modified flag */
     __forceinline void setModified(bool f = true) { 
       modified = f; 
@@ -195,8 +226,10 @@ namespace embree
     __forceinline bool isFastAccel() const { return !isCompactAccel() && !isRobustAccel(); }
     __forceinline bool isCompactAccel() const { return scene_flags & RTC_SCENE_FLAG_COMPACT; }
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
+    __forceinline bool isWatertightAccel() const { return scene_flags & RTC_SCENE_FLAG_WATERTIGHT; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+    __forceinline bool isDoubleBufferedAccel() const { return scene_flags & RTC_SCENE_FLAG_DOUBLE_BUFFERED; }
     
     __forceinline bool hasContextFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION;
@@ -207,6 +240,11 @@ namespace embree
     __forceinline bool hasFilterFunction() {
       return hasContextFilterFunction() || hasGeometryFilterFunction();
     }
+
+    /*! returns true if back faces of some geometry may get culled for the specified intersection context flags */
+    __forceinline bool hasBackfaceCulling(const RTCIntersectContextFlags flags) const {
+      return (flags & RTC_INTERSECT_CONTEXT_FLAG_BACKFACE_CULLING) || numBackfaceCullingGeometries != 0;
+    }
     
     /* test if scene got already build */
     __forceinline bool isBuild() const { return is_build; }
@@ -221,12 +259,64 @@ namespace embree
     bool flags_modified;
     RTCSceneFlags scene_flags;
     RTCBuildQuality quality_flags;
+    BBox1f time_range;               //!< time range motion blur accels get build for
+    RTCBuildPriority build_priority;
+    size_t build_thread_count;       //!< maximal number of build threads, 0 uses all threads
+    std::atomic<size_t> commitGeneration;  //!< generation of the most recently requested commit
+    std::atomic<size_t> buildGeneration;   //!< generation of the commit in progress
+    std::atomic<size_t> cancelGeneration;  //!< generation of the most recently cancelled commit
     AccelN accels;
     MutexSys buildMutex;
     SpinLock geometriesMutex;
     bool is_build;
     bool modified;                   //!< true if scene got modified
     
+    std::atomic<AccelN*> frontAccels;     //!< acceleration structures traced by double buffered scenes
+    std::atomic<size_t> epoch;            //!< incremented whenever the front acceleration structures get replaced
+    std::atomic<size_t> epochReaders[2];  //!< number of queries in flight that entered an even or odd epoch
+
+    /*! Pins the front acceleration structures of a double buffered scene during a query. Old
+     *  front acceleration structures get only freed once all queries of their epoch finished. */
+    struct EpochGuard
+    {
+      __forceinline EpochGuard (Scene* scene)
+        : scene(scene)
+      {
+        while (true)
+        {
+          const size_t e = scene->epoch.load();
+          slot = e & 1;
+          scene->epochReaders[slot]++;
+          if (likely(scene->epoch.load() == e)) break;
+          scene->epochReaders[slot]--;
+        }
+        accels = scene->frontAccels.load();
+      }
+
+      __forceinline ~EpochGuard () {
+        scene->epochReaders[slot]--;
+      }
+
+    public:
+      Scene* scene;
+      size_t slot;
+      AccelN* accels;
+    };
+
+  public:
+    static void intersectFront (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context);
+    static void intersectFront4 (const void* valid, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context);
+    static void intersectFront8 (const void* valid, Accel::Intersectors* This, RTCRayHit8& ray, IntersectContext* context);
+    static void intersectFront16 (const void* valid, Accel::Intersectors* This, RTCRayHit16& ray, IntersectContext* context);
+    static void intersectFrontN (Accel::Intersectors* This, RayHitK<VSIZEX>** ray, const size_t N, IntersectContext* context);
+    static void occludedFront (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context);
+    static void occludedFront4 (const void* valid, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context);
+    static void occludedFront8 (const void* valid, Accel::Intersectors* This, RTCRay8& ray, IntersectContext* context);
+    static void occludedFront16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context);
+    static void occludedFrontN (Accel::Intersectors* This, RayK<VSIZEX>** ray, const size_t N, IntersectContext* context);
+    static bool pointQueryFront (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+
+  public:
     /*! global lock step task scheduler */
 #if defined(TASKING_INTERNAL) 
     MutexSys schedulerMutex;
@@ -294,8 +384,47 @@ namespace embree
       Scene::Iterator<Mesh,mblur> iter(this);
       return iter.maxTimeStepsPerGeometry();
     }
+
+    /*! returns true if all geometries of the specified type use uniform time steps over [0,1] */
+    template<typename Mesh, bool mblur>
+    __forceinline bool hasDefaultTimeSteps()
+    {
+      Scene::Iterator<Mesh,mblur> iter(this);
+      return iter.allDefaultTimeSteps();
+    }
    
     std::atomic<size_t> numIntersectionFiltersN;   //!< number of enabled intersection/occlusion filters for N-wide ray packets
+    std::atomic<size_t> numBackfaceCullingGeometries; //!< number of enabled geometries with backface culling
+  };
+
+  /*! Asynchronous commit of a scene, executed by a separate thread. Other
+   *  threads can join the build through rtcJoinCommitScene. */
+  class AsyncCommit : public RefCount
+  {
+  public:
+    AsyncCommit (Scene* scene, RTCCommitCompletionFunction completion, void* ptr);
+    ~AsyncCommit ();
+
+    /*! returns true if the commit finished */
+    bool isDone() const { return done; }
+
+    /*! waits for the commit to finish and returns its error code */
+    RTCError wait();
+
+  private:
+    static void run(void* ptr);
+
+  public:
+    Ref<Scene> scene;
+    
+  private:
+    size_t generation;   //!< generation of the requested commit, cancels issued after the request apply to it
+    RTCCommitCompletionFunction completion;
+    void* ptr;
+    thread_t thread;
+    MutexSys mutex;
+    std::atomic<bool> done;
+    RTCError error;
   };
 
   template<> __forceinline size_t Scene::getNumPrimitives<TriangleMesh,false>() const { return world.numTriangles; }
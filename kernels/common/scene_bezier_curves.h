@@ -143,7 +143,7 @@ namespace embree
                               float time) const
     {
       float ftime;
-      const size_t itime = getTimeSegment(time, fnumTimeSegments, ftime);
+      const size_t itime = timeSegment(time, ftime);
 
       const float t0 = 1.0f - ftime;
       const float t1 = ftime;
@@ -229,12 +229,12 @@ namespace embree
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
     __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& time_range) const {
-      return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, time_range, fnumTimeSegments);
+      return timeLinearBounds([&] (size_t itime) { return bounds(primID, itime); }, time_range);
     }
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
     __forceinline LBBox3fa linearBounds(const AffineSpace3fa& space, size_t primID, const BBox1f& time_range) const {
-      return LBBox3fa([&] (size_t itime) { return bounds(space, primID, itime); }, time_range, fnumTimeSegments);
+      return timeLinearBounds([&] (size_t itime) { return bounds(space, primID, itime); }, time_range);
     }
 
     /*! calculates the build bounds of the i'th primitive, if it's valid */
@@ -290,7 +290,7 @@ namespace embree
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
     __forceinline bool linearBounds(size_t i, const BBox1f& time_range, LBBox3fa& bbox) const  {
-      if (!valid(i, getTimeSegmentRange(time_range, fnumTimeSegments))) return false;
+      if (!valid(i, timeStepRange(time_range))) return false;
       bbox = linearBounds(i, time_range);
       return true;
     }
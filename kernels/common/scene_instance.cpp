@@ -29,13 +29,16 @@ namespace embree
   }
 
   Instance::Instance (Device* device, Scene* object, unsigned int numTimeSteps) 
-    : AccelSet(device,1,numTimeSteps), object(object), local2world(nullptr)
+    : AccelSet(device,1,numTimeSteps), object(object), local2world(nullptr), qd(nullptr), quaternion(false), origin(0.0), originf(zero)
   {
     if (object) object->refInc();
     world2local0 = one;
     local2world = (AffineSpace3fa*) alignedMalloc(numTimeSteps*sizeof(AffineSpace3fa));
-    for (size_t i = 0; i < numTimeSteps; i++)
+    qd = (QuaternionDecomposition*) alignedMalloc(numTimeSteps*sizeof(QuaternionDecomposition));
+    for (size_t i = 0; i < numTimeSteps; i++) {
       local2world[i] = one;
+      qd[i] = one;
+    }
     intersectors.ptr = this;
     boundsFunc = device->instance_factory->InstanceBoundsFunc();
     intersectors.intersectorN = device->instance_factory->InstanceIntersectorN();
@@ -44,6 +47,7 @@ namespace embree
   Instance::~Instance()
   {
     alignedFree(local2world);
+    alignedFree(qd);
     if (object) object->refDec();
   }
 
@@ -53,15 +57,22 @@ namespace embree
       return;
     
     AffineSpace3fa* local2world2 = (AffineSpace3fa*) alignedMalloc(numTimeSteps_in*sizeof(AffineSpace3fa));
+    QuaternionDecomposition* qd2 = (QuaternionDecomposition*) alignedMalloc(numTimeSteps_in*sizeof(QuaternionDecomposition));
      
-    for (size_t i = 0; i < min(numTimeSteps, numTimeSteps_in); i++)
+    for (size_t i = 0; i < min(numTimeSteps, numTimeSteps_in); i++) {
       local2world2[i] = local2world[i];
+      qd2[i] = qd[i];
+    }
 
-    for (size_t i = numTimeSteps; i < numTimeSteps_in; i++)
+    for (size_t i = numTimeSteps; i < numTimeSteps_in; i++) {
       local2world2[i] = one;
+      qd2[i] = one;
+    }
         
     alignedFree(local2world);
+    alignedFree(qd);
     local2world = local2world2;
+    qd = qd2;
     
     Geometry::setNumTimeSteps(numTimeSteps_in);
   }
@@ -79,11 +90,90 @@ namespace embree
     if (timeStep >= numTimeSteps)
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid timestep");
 
+    /* switching the transformation format resets all other time steps */
+    if (quaternion) 
+    {
+      for (size_t i = 0; i < numTimeSteps; i++) {
+        local2world[i] = one;
+        qd[i] = one;
+      }
+      world2local0 = one;
+      quaternion = false;
+    }
+
     local2world[timeStep] = xfm;
     if (timeStep == 0)
       world2local0 = rcp(xfm);
   }
 
+  void Instance::setQuaternionDecomposition(const QuaternionDecomposition& xfm, unsigned int timeStep)
+  {
+    if (timeStep >= numTimeSteps)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid timestep");
+
+    const float len = abs(xfm.rotation);
+    if (!(len > 0.0f) || len == float(pos_inf))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid rotation quaternion");
+
+    /* switching the transformation format resets all other time steps */
+    if (!quaternion)
+    {
+      for (size_t i = 0; i < numTimeSteps; i++) {
+        local2world[i] = one;
+        qd[i] = one;
+      }
+      world2local0 = one;
+      quaternion = true;
+    }
+
+    qd[timeStep] = QuaternionDecomposition(xfm.scale,xfm.rotation*rcp(len),xfm.translation);
+    local2world[timeStep] = qd[timeStep].local2world();
+    if (timeStep == 0)
+      world2local0 = qd[0].world2local();
+  }
+
+  void Instance::commit()
+  {
+    /* opposite quaternions describe a full turn around an undefined axis */
+    if (quaternion)
+    {
+      for (unsigned int i = 0; i+1 < numTimeSteps; i++)
+        if (dot(qd[i+0].rotation,qd[i+1].rotation) < -0.9995f)
+          throw_RTCError(RTC_ERROR_INVALID_OPERATION,"opposite rotation quaternions at consecutive time steps");
+    }
+    Geometry::commit();
+  }
+
+  float Instance::sweepPadding(unsigned int itime, float radius) const
+  {
+    if (!quaternion)
+      return 0.0f;
+
+    const QuaternionDecomposition& a = qd[itime+0];
+    const QuaternionDecomposition& b = qd[itime+1];
+
+    /* a vector of length r rotated by slerp deviates from the linear
+     * interpolation of its end positions by at most r*(1-cos(h)) along
+     * the chord normal and r*(h-sin(h)) along the chord, where h is
+     * half the rotation angle between the two time steps, slerp follows
+     * the signs of the quaternions thus h ranges up to pi */
+    const float cosHalfAngle = clamp(dot(a.rotation,b.rotation),-1.0f,1.0f);
+    const float halfAngle = acos(cosHalfAngle);
+    const float sinHalfAngle = sin(halfAngle);
+    const float arc = (1.0f-cosHalfAngle) + (halfAngle-sinHalfAngle);
+
+    /* linear scaling under a changing rotation adds at most t*(1-t)*|R0-R1|*|S1-S0| */
+    const float maxScale = max(reduce_max(abs(a.scale)),reduce_max(abs(b.scale)));
+    const float dScale = reduce_max(abs(b.scale-a.scale));
+    return radius*(maxScale*arc + 0.5f*sinHalfAngle*dScale);
+  }
+
+  void Instance::setTransformOrigin(const Vec3<double>& origin_in)
+  {
+    origin = origin_in;
+    originf = Vec3fa(float(origin.x),float(origin.y),float(origin.z));
+  }
+
   AffineSpace3fa Instance::getTransform(float time)
   {
     return getWorld2Local(time);
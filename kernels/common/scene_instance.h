@@ -20,6 +20,43 @@
 
 namespace embree
 {
+  /*! Transformation decomposed into scale, rotation quaternion, and translation */
+  struct QuaternionDecomposition
+  {
+    __forceinline QuaternionDecomposition () {}
+
+    __forceinline QuaternionDecomposition (OneTy)
+      : scale(one), rotation(one), translation(zero) {}
+
+    __forceinline QuaternionDecomposition (const Vec3fa& scale, const Quaternion3f& rotation, const Vec3fa& translation)
+      : scale(scale), rotation(rotation), translation(translation) {}
+
+    /*! returns the transformation from local space to world space */
+    __forceinline AffineSpace3fa local2world() const {
+      return AffineSpace3fa(LinearSpace3fa(rotation)*LinearSpace3fa::scale(scale),translation);
+    }
+
+    /*! returns the transformation from world space to local space */
+    __forceinline AffineSpace3fa world2local() const 
+    {
+      const LinearSpace3fa l = LinearSpace3fa::scale(rcp(scale))*LinearSpace3fa(conj(rotation));
+      return AffineSpace3fa(l,-xfmVector(l,translation));
+    }
+
+  public:
+    Vec3fa scale;           //!< scaling along the local coordinate axes
+    Quaternion3f rotation;  //!< unit quaternion applied after scaling
+    Vec3fa translation;     //!< translation applied after rotation
+  };
+
+  /*! interpolates scale and translation linearly and the rotation spherically */
+  __forceinline QuaternionDecomposition slerp(const QuaternionDecomposition& a, const QuaternionDecomposition& b, const float t)
+  {
+    return QuaternionDecomposition(lerp(a.scale,b.scale,t),
+                                   slerp(a.rotation,b.rotation,t),
+                                   lerp(a.translation,b.translation,t));
+  }
+
   class InstanceFactory
   {
   public:
@@ -44,12 +81,44 @@ namespace embree
     virtual void setNumTimeSteps (unsigned int numTimeSteps);
     virtual void setInstancedScene(const Ref<Scene>& scene);
     virtual void setTransform(const AffineSpace3fa& local2world, unsigned int timeStep);
+    virtual void setQuaternionDecomposition(const QuaternionDecomposition& qd, unsigned int timeStep);
+    virtual void setTransformOrigin(const Vec3<double>& origin);
     virtual AffineSpace3fa getTransform(float time);
     virtual void setMask (unsigned mask);
+    virtual void commit();
     virtual void build() {}
 
+    /*! returns by how much the bounds of a time step have to get
+     *  extended to enclose the rotational sweep of an object with
+     *  the given bounding radius over the specified time segment */
+    float sweepPadding(unsigned int itime, float radius) const;
+
   public:
 
+    /*! returns the ray origin relative to the origin of the instance,
+     *  re-based in double precision if a double precision origin is given */
+    __forceinline Vec3fa rebaseOrigin(const Vec3fa& org, const double* dorg) const
+    {
+      if (likely(dorg == nullptr)) return org-originf;
+      return Vec3fa(float(dorg[0]-origin.x),float(dorg[1]-origin.y),float(dorg[2]-origin.z));
+    }
+
+    template<int K>
+      __forceinline Vec3vf<K> rebaseOrigin(const vbool<K>& valid, const Vec3vf<K>& org, const double* dorgs, const vint<K>& rayID) const
+    {
+      Vec3vf<K> rel = org-Vec3vf<K>(originf);
+      if (likely(dorgs == nullptr)) return rel;
+      size_t bits = movemask(valid);
+      while (bits) {
+        const size_t i = __bscf(bits);
+        const double* dorg = &dorgs[3*size_t(unsigned(rayID[i]))];
+        rel.x[i] = float(dorg[0]-origin.x);
+        rel.y[i] = float(dorg[1]-origin.y);
+        rel.z[i] = float(dorg[2]-origin.z);
+      }
+      return rel;
+    }
+
     __forceinline AffineSpace3fa getWorld2Local() const {
       return world2local0;
     }
@@ -57,15 +126,32 @@ namespace embree
     __forceinline AffineSpace3fa getWorld2Local(float t) const 
     {
       float ftime;
-      const unsigned int itime = getTimeSegment(t, fnumTimeSegments, ftime);
+      const unsigned int itime = timeSegment(t, ftime);
+      if (unlikely(quaternion))
+        return slerp(qd[itime+0],qd[itime+1],ftime).world2local();
       return rcp(lerp(local2world[itime+0],local2world[itime+1],ftime));
     }
 
     template<int K>
       __forceinline AffineSpace3vf<K> getWorld2Local(const vbool<K>& valid, const vfloat<K>& t) const
     { 
+      if (unlikely(quaternion))
+      {
+        AffineSpace3vf<K> space;
+        size_t bits = movemask(valid);
+        while (bits) {
+          const size_t i = __bscf(bits);
+          const AffineSpace3fa xfm = getWorld2Local(t[i]);
+          space.l.vx.x[i] = xfm.l.vx.x; space.l.vx.y[i] = xfm.l.vx.y; space.l.vx.z[i] = xfm.l.vx.z;
+          space.l.vy.x[i] = xfm.l.vy.x; space.l.vy.y[i] = xfm.l.vy.y; space.l.vy.z[i] = xfm.l.vy.z;
+          space.l.vz.x[i] = xfm.l.vz.x; space.l.vz.y[i] = xfm.l.vz.y; space.l.vz.z[i] = xfm.l.vz.z;
+          space.p.x[i]    = xfm.p.x;    space.p.y[i]    = xfm.p.y;    space.p.z[i]    = xfm.p.z;
+        }
+        return space;
+      }
+
       vfloat<K> ftime;
-      const vint<K> itime_k = getTimeSegment(t, vfloat<K>(fnumTimeSegments), ftime);
+      const vint<K> itime_k = timeSegment(t, ftime);
       assert(any(valid));
       const size_t index = __bsf(movemask(valid));
       const int itime = itime_k[index];
@@ -87,5 +173,9 @@ namespace embree
     Scene* object;                 //!< pointer to instanced acceleration structure
     AffineSpace3fa world2local0;   //!< transformation from world space to local space for timestep 0
     AffineSpace3fa* local2world;   //!< transformation from local space to world space for each timestep
+    QuaternionDecomposition* qd;   //!< quaternion decomposition of the transformation for each timestep
+    bool quaternion;               //!< true if transformations are interpolated using their quaternion decomposition
+    Vec3<double> origin;           //!< double precision origin the transformations are relative to
+    Vec3fa originf;                //!< origin rounded to single precision
   };
 }
@@ -95,6 +95,14 @@ namespace embree
     Geometry::setNumTimeSteps(numTimeSteps);
   }
 
+  void SubdivMesh::setTimeRange (const BBox1f& range) {
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"time range not supported for subdivision meshes");
+  }
+
+  void SubdivMesh::setTimeSteps (const float* times) {
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"time steps not supported for subdivision meshes");
+  }
+
   void SubdivMesh::setVertexAttributeCount (unsigned int N)
   {
     vertexAttribs.resize(N);
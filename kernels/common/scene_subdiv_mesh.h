@@ -70,6 +70,8 @@ namespace embree
     void setSubdivisionMode (unsigned int topologyID, RTCSubdivisionMode mode);
     void setVertexAttributeTopology(unsigned int vertexAttribID, unsigned int topologyID);
     void setNumTimeSteps (unsigned int numTimeSteps);
+    void setTimeRange (const BBox1f& range);
+    void setTimeSteps (const float* times);
     void setVertexAttributeCount (unsigned int N);
     void setTopologyCount (unsigned int N);
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
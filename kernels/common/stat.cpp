@@ -16,6 +16,12 @@
 
 #include "stat.h"
 
+#if defined(__LINUX__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace embree
 {
   Stat Stat::instance; 
@@ -138,4 +144,90 @@ namespace embree
     cout << "#user7/user3 " << 100.0f*float(cntrs.user[7])/float(cntrs.user[3]) << "%" << std::endl;
     cout << std::endl;
   }
+
+#if defined(__LINUX__)
+
+  static int openPerfCounter(unsigned long long config)
+  {
+    perf_event_attr attr;
+    memset(&attr,0,sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(__NR_perf_event_open,&attr,0,-1,-1,0);
+  }
+
+  static bool readPerfCounter(int fd, size_t& value)
+  {
+    unsigned long long v = 0;
+    if (read(fd,&v,sizeof(v)) != sizeof(v)) return false;
+    value = size_t(v);
+    return true;
+  }
+
+  /*! perf_event file descriptors of a thread, they get opened at the
+   *  first sample of the thread and closed when the thread exits */
+  struct PerfCounters
+  {
+    PerfCounters ()
+    {
+      fd_cycles = openPerfCounter(PERF_COUNT_HW_CPU_CYCLES);
+      fd_llc_misses = openPerfCounter(PERF_COUNT_HW_CACHE_MISSES);
+      if (fd_cycles < 0 || fd_llc_misses < 0) close();
+    }
+
+    ~PerfCounters () {
+      close();
+    }
+
+    void close()
+    {
+      if (fd_cycles >= 0) ::close(fd_cycles);
+      if (fd_llc_misses >= 0) ::close(fd_llc_misses);
+      fd_cycles = fd_llc_misses = -1;
+    }
+
+    bool read(size_t& cycles, size_t& llcMisses) const
+    {
+      if (fd_cycles < 0) return false;
+      return readPerfCounter(fd_cycles,cycles) && readPerfCounter(fd_llc_misses,llcMisses);
+    }
+
+  private:
+    int fd_cycles;     //!< -1 if not available
+    int fd_llc_misses;
+  };
+
+  static bool readPerfCounters(size_t& cycles, size_t& llcMisses)
+  {
+    static thread_local PerfCounters counters;
+    return counters.read(cycles,llcMisses);
+  }
+
+#else
+
+  static bool readPerfCounters(size_t& cycles, size_t& llcMisses) {
+    return false;
+  }
+
+#endif
+
+  void QueryStatistics::begin(RTCTraversalStatistics* statistics, bool occluded, size_t numRays)
+  {
+    counters = occluded ? &statistics->occluded : &statistics->intersect;
+    counters->calls++;
+    counters->rays += numRays;
+    perf = (statistics->flags & RTC_TRAVERSAL_STATISTICS_FLAG_PERF_COUNTERS) && readPerfCounters(cycles,llcMisses);
+  }
+
+  void QueryStatistics::end()
+  {
+    size_t cycles1, llcMisses1;
+    if (perf && readPerfCounters(cycles1,llcMisses1)) {
+      counters->cycles += cycles1-cycles;
+      counters->llcMisses += llcMisses1-llcMisses;
+    }
+  }
 }
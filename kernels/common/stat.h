@@ -17,6 +17,7 @@
 #pragma once
 
 #include "default.h"
+#include "rtcore.h"
 
 /* Macros to gather statistics */
 #ifdef EMBREE_STAT_COUNTERS
@@ -125,4 +126,44 @@ namespace embree
   private:
     static Stat instance;
   };
+
+  /*! Gathers the traversal statistics of a ray query call for
+   *  intersection contexts that have statistics attached. Counts the
+   *  call and its rays, and samples the hardware performance counters
+   *  of the calling thread around the call if requested. */
+  class QueryStatistics
+  {
+  public:
+
+    __forceinline QueryStatistics (const RTCIntersectContext* context, bool occluded, size_t numRays)
+      : counters(nullptr)
+    {
+      if (unlikely(context->statistics != nullptr))
+        begin(context->statistics,occluded,numRays);
+    }
+
+    __forceinline QueryStatistics (const RTCIntersectContext* context, bool occluded, const int* valid, size_t K)
+      : counters(nullptr)
+    {
+      if (unlikely(context->statistics != nullptr)) {
+        size_t numRays = 0;
+        for (size_t i=0; i<K; i++) numRays += valid[i] != 0;
+        begin(context->statistics,occluded,numRays);
+      }
+    }
+
+    __forceinline ~QueryStatistics () {
+      if (unlikely(counters != nullptr)) end();
+    }
+
+  private:
+    void begin(RTCTraversalStatistics* statistics, bool occluded, size_t numRays);
+    void end();
+
+  private:
+    RTCTraversalCounters* counters;
+    bool perf;
+    size_t cycles;
+    size_t llcMisses;
+  };
 }
@@ -94,6 +94,8 @@ namespace embree
     object_accel_mb_max_leaf_size = 1;
 
     max_spatial_split_replications = 2.0f;
+    spatial_split_budget = false;
+    hlbvh_treelet_size = 1024;
 
     tessellation_cache_size = 128*1024*1024;
 
@@ -104,6 +106,8 @@ namespace embree
       if (singledevice) tessellation_cache_size = 128*1024*1024;
 #endif
 
+    build_arena_size = 0;
+
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
 
@@ -121,6 +125,7 @@ namespace embree
     benchmark = 0;
 
     numThreads = 0;
+    numUserThreads = 0;
 #if TASKING_INTERNAL
     set_affinity = true;
 #else
@@ -137,6 +142,7 @@ namespace embree
     hugepages = false;
 #endif
     hugepages_success = true;
+    transparent_hugepages = false;
 
     alloc_main_block_size = 0;
     alloc_num_main_slots = 0;
@@ -148,6 +154,11 @@ namespace embree
 
     memory_monitor_function = nullptr;
     memory_monitor_userptr = nullptr;
+
+    alloc_function = nullptr;
+    free_function = nullptr;
+    shrink_function = nullptr;
+    allocator_userptr = nullptr;
   }
 
   State::~State() {
@@ -248,6 +259,9 @@ namespace embree
       if (tok == Token::Id("threads") && cin->trySymbol("=")) 
         numThreads = cin->get().Int();
 
+      else if (tok == Token::Id("user_threads") && cin->trySymbol("=")) 
+        numUserThreads = cin->get().Int();
+
       else if (tok == Token::Id("set_affinity")&& cin->trySymbol("=")) 
         set_affinity = cin->get().Int();
 
@@ -280,6 +294,9 @@ namespace embree
       else if (tok == Token::Id("hugepages") && cin->trySymbol("=")) {
         hugepages = cin->get().Int();
       }
+      else if (tok == Token::Id("transparent_hugepages") && cin->trySymbol("=")) {
+        transparent_hugepages = cin->get().Int();
+      }
 
       else if (tok == Token::Id("ignore_config_files") && cin->trySymbol("="))
         ignore_config_files = cin->get().Int();
@@ -402,6 +419,8 @@ namespace embree
             if (flag == Token::Id("dynamic") ) scene_flags |= RTC_SCENE_FLAG_DYNAMIC;
             else if (flag == Token::Id("compact")) scene_flags |= RTC_SCENE_FLAG_COMPACT;
             else if (flag == Token::Id("robust")) scene_flags |= RTC_SCENE_FLAG_ROBUST;
+            else if (flag == Token::Id("watertight")) scene_flags |= RTC_SCENE_FLAG_WATERTIGHT;
+            else if (flag == Token::Id("double_buffered")) scene_flags |= RTC_SCENE_FLAG_DOUBLE_BUFFERED;
           } while (cin->trySymbol("|"));
         }
       }
@@ -409,11 +428,20 @@ namespace embree
       else if (tok == Token::Id("max_spatial_split_replications") && cin->trySymbol("="))
         max_spatial_split_replications = cin->get().Float();
 
+      else if (tok == Token::Id("spatial_split_budget") && cin->trySymbol("="))
+        spatial_split_budget = cin->get().Int();
+
+      else if (tok == Token::Id("hlbvh_treelet_size") && cin->trySymbol("="))
+        hlbvh_treelet_size = cin->get().Int();
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
 
+      else if (tok == Token::Id("build_arena_size") && cin->trySymbol("="))
+        build_arena_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
        else if (tok == Token::Id("alloc_num_main_slots") && cin->trySymbol("="))
@@ -435,6 +463,7 @@ namespace embree
   {
     std::cout << "general:" << std::endl;
     std::cout << "  build threads = " << numThreads   << std::endl;
+    std::cout << "  user threads  = " << numUserThreads << std::endl;
     std::cout << "  start_threads = " << start_threads << std::endl;
     std::cout << "  affinity      = " << set_affinity << std::endl;
     
@@ -443,9 +472,13 @@ namespace embree
     else if (hugepages_success) std::cout << "enabled" << std::endl;
     else std::cout << "failed" << std::endl;
 
+    std::cout << "  transparent_hugepages = " << transparent_hugepages << std::endl;
     std::cout << "  verbosity     = " << verbose << std::endl;
     std::cout << "  cache_size    = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  build_arena_size = " << float(build_arena_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  spatial_split_budget = " << spatial_split_budget << std::endl;
+    std::cout << "  hlbvh_treelet_size = " << hlbvh_treelet_size << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel         = " << tri_accel << std::endl;
@@ -111,7 +111,10 @@ namespace embree
 
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
+    bool spatial_split_budget;             //!< budgets spatial split replications per subtree by SAH gain and sizes primref array by estimated demand
+    size_t hlbvh_treelet_size;             //!< maximal number of primitives of a morton treelet in the HLBVH builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    size_t build_arena_size;               //!< maximal number of bytes of build temporaries kept alive across builds
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -130,6 +133,7 @@ namespace embree
     
   public:
     size_t numThreads;                     //!< number of threads to use in builders
+    size_t numUserThreads;                 //!< number of application threads that join the thread pool instead of own threads, the shared pool reserves the maximum of all devices
     bool set_affinity;                     //!< sets affinity for worker threads
     bool start_threads;                    //!< true when threads should be started at device creation time
     int enabled_cpu_features;              //!< CPU ISA features to use
@@ -137,6 +141,7 @@ namespace embree
     bool enable_selockmemoryprivilege;     //!< configures the SeLockMemoryPrivilege under Windows to enable huge pages
     bool hugepages;                        //!< true if huge pages should get used
     bool hugepages_success;                //!< status for enabling huge pages
+    bool transparent_hugepages;            //!< true if large allocations should get 2MB aligned and advised to use transparent huge pages
 
   public:
     size_t alloc_main_block_size;          //!< main allocation block size (shared between threads)
@@ -179,5 +184,11 @@ namespace embree
       
     RTCMemoryMonitorFunction memory_monitor_function;
     void* memory_monitor_userptr;
+
+  public:
+    RTCAllocFunction alloc_function;
+    RTCFreeFunction free_function;
+    RTCShrinkFunction shrink_function;
+    void* allocator_userptr;
   };
 }
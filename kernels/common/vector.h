@@ -18,9 +18,26 @@
 
 namespace embree
 {
-  /*! invokes the memory monitor callback */
+  /*! invokes the memory monitor callback and the allocator of the device */
   struct MemoryMonitorInterface {
     virtual void memoryMonitor(ssize_t bytes, bool post) = 0;
+
+    /*! allocates memory, OS allocations are page granular and return
+     *  whether they got huge pages, for other allocations hugepages is
+     *  only a hint */
+    virtual void* memoryAlloc(size_t bytes, size_t align, bool os, bool& hugepages) = 0;
+
+    /*! frees memory allocated with memoryAlloc */
+    virtual void memoryFree(void* ptr, size_t bytes, bool os, bool hugepages) = 0;
+
+    /*! shrinks an OS allocation and returns its new size */
+    virtual size_t memoryShrink(void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages) = 0;
+
+    /*! allocates memory of monitored vectors and reports it to the memory monitor, freed memory may get reused by later allocations */
+    virtual void* arenaAlloc(size_t bytes, size_t align, bool os, bool& hugepages) = 0;
+
+    /*! frees memory allocated with arenaAlloc, memory kept for reuse stays reported to the memory monitor */
+    virtual void arenaFree(void* ptr, size_t bytes, bool os, bool hugepages) = 0;
   };
 
   /*! allocator that performs aligned monitored allocations */
@@ -40,34 +57,22 @@ namespace embree
 
       __forceinline pointer allocate( size_type n ) 
       {
-        if (n) {
-          assert(device);
-          device->memoryMonitor(n*sizeof(T),false);
-        }
-        if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
-        {
-          pointer p =  (pointer) os_malloc(n*sizeof(value_type),hugepages);
-          assert(p);
-          return p;
-        }
-        return (pointer) alignedMalloc(n*sizeof(value_type),alignment);
+        if (n == 0) return nullptr;
+        assert(device);
+        const bool os = n*sizeof(value_type) >= 14 * PAGE_SIZE_2M;
+        pointer p = (pointer) device->arenaAlloc(n*sizeof(value_type),alignment,os,hugepages);
+        assert(p);
+        return p;
       }
 
       __forceinline void deallocate( pointer p, size_type n ) 
       {
         if (p)
         {
-          if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
-            os_free(p,n*sizeof(value_type),hugepages); 
-          else
-            alignedFree(p);
+          const bool os = n*sizeof(value_type) >= 14 * PAGE_SIZE_2M;
+          device->arenaFree(p,n*sizeof(value_type),os,hugepages);
         }
         else assert(n == 0);
-
-        if (n) {
-          assert(device);
-          device->memoryMonitor(-ssize_t(n)*sizeof(T),true);
-        }
       }
 
       __forceinline void construct( pointer p, const_reference val ) {
@@ -20,6 +20,7 @@
 #include "bezier_hair_intersector.h"
 #include "bezier_ribbon_intersector.h"
 #include "bezier_curve_intersector.h"
+#include "point_query_intersector.h"
 
 namespace embree
 {
@@ -61,6 +62,14 @@ namespace embree
         else
           return pre.intersectorCurve.intersect(ray,a0,a1,a2,a3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
       }
+
+      /*! Computes the closest point on the curve. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        const NativeCurves* geom = (NativeCurves*) context->scene->get(prim.geomID());
+        Vec3fa p0,p1,p2,p3; geom->gather(p0,p1,p2,p3,prim.vertexID);
+        return pointQueryCurve(query,context,Curve3fa(p0,p1,p2,p3),prim.geomID(),prim.primID());
+      }
     };
 
     template<int K>
@@ -159,6 +168,14 @@ namespace embree
         else
           return pre.intersectorCurve.intersect(ray,p0,p1,p2,p3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
       }
+
+      /*! Computes the closest point on the curve. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        const NativeCurves* geom = (NativeCurves*) context->scene->get(prim.geomID());
+        Vec3fa p0,p1,p2,p3; geom->gather(p0,p1,p2,p3,prim.vertexID,query->time);
+        return pointQueryCurve(query,context,Curve3fa(p0,p1,p2,p3),prim.geomID(),prim.primID());
+      }
     };
 
     template<int K>
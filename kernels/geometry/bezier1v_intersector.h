@@ -20,6 +20,7 @@
 #include "bezier_hair_intersector.h"
 #include "bezier_ribbon_intersector.h"
 #include "bezier_curve_intersector.h"
+#include "point_query_intersector.h"
 
 namespace embree
 {
@@ -61,6 +62,12 @@ namespace embree
           return pre.intersectorCurve.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
       }
 
+      /*! Computes the closest point on the curve. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return pointQueryCurve(query,context,Curve3fa(prim.p0,prim.p1,prim.p2,prim.p3),prim.geomID(),prim.primID());
+      }
+
       /*! Intersect an array of rays with an array of M primitives. */
       /* static __forceinline size_t intersect(Precalculations* pre, size_t valid, RayHit** rays, IntersectContext* context, const Primitive* prim, size_t num) */
       /* { */
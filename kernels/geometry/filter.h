@@ -30,6 +30,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        context->countFilterCall(false);
         geometry->intersectionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -38,6 +39,7 @@ namespace embree
             
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        context->countFilterCall(false);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -68,6 +70,7 @@ namespace embree
       const Geometry* const geometry = args->geometry;
       if (geometry->intersectionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
+        context->countFilterCall(false);
         geometry->intersectionFilterN(filter_args);
       }
       
@@ -76,6 +79,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        context->countFilterCall(false);
         context->user->filter(filter_args);
       }
 #endif
@@ -86,6 +90,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        context->countFilterCall(true);
         geometry->occlusionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -94,6 +99,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        context->countFilterCall(true);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -122,6 +128,7 @@ namespace embree
       const Geometry* const geometry = args->geometry;
       if (geometry->occlusionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
+        context->countFilterCall(true);
         geometry->occlusionFilterN(filter_args);
       }
       
@@ -130,6 +137,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        context->countFilterCall(true);
         context->user->filter(filter_args);
       }
 #endif
@@ -142,6 +150,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        context->countFilterCall(false);
         geometry->intersectionFilterN(args);
       }
 
@@ -150,6 +159,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        context->countFilterCall(false);
         context->user->filter(args);
       }
 
@@ -181,6 +191,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        context->countFilterCall(true);
         geometry->occlusionFilterN(args);
       }
 
@@ -190,6 +201,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        context->countFilterCall(true);
         context->user->filter(args);
       }
 
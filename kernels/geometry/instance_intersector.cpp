@@ -28,14 +28,35 @@ namespace embree
 
       assert(itime < instance->numTimeSteps);
       unsigned num_time_segments = instance->numTimeSegments();
+      BBox3fa bounds;
       if (num_time_segments == 0) {
-        *((BBox3fa*)args->bounds_o) = xfmBounds(instance->local2world[itime],instance->object->bounds.bounds());
+        bounds = xfmBounds(instance->local2world[itime],instance->object->bounds.bounds());
       }
       else {
-        const float ftime = float(itime) / float(num_time_segments);
+        const float ftime = instance->timeStep(itime);
         const BBox3fa obounds = instance->object->bounds.interpolate(ftime);
-        *((BBox3fa*)args->bounds_o) = xfmBounds(instance->local2world[itime],obounds);
+        bounds = xfmBounds(instance->local2world[itime],obounds);
+
+        /* enlarge bounds to enclose the rotational sweep of both adjacent time segments */
+        if (unlikely(instance->quaternion))
+        {
+          const BBox3fa ubounds = instance->object->bounds.bounds();
+          const float radius = length(max(abs(ubounds.lower),abs(ubounds.upper)));
+          float pad = 0.0f;
+          if (itime > 0)                 pad = max(pad,instance->sweepPadding(itime-1,radius));
+          if (itime < num_time_segments) pad = max(pad,instance->sweepPadding(itime+0,radius));
+          bounds = enlarge(bounds,Vec3fa(pad));
+        }
+      }
+
+      /* the origin of the instance got rounded to single precision */
+      if (unlikely(instance->origin != Vec3<double>(0.0)))
+      {
+        bounds = BBox3fa(bounds.lower+instance->originf,bounds.upper+instance->originf);
+        const float pad = float(ulp)*reduce_max(max(abs(bounds.lower),abs(bounds.upper)));
+        bounds = enlarge(bounds,Vec3fa(2.0f*pad));
       }
+      *((BBox3fa*)args->bounds_o) = bounds;
     }
 
     RTCBoundsFunction InstanceBoundsFunc() {
@@ -52,7 +73,8 @@ namespace embree
         likely(instance->numTimeSteps == 1) ? instance->getWorld2Local() : instance->getWorld2Local(ray.time());
       const Vec3fa ray_org = ray.org;
       const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+      const double* dorg = user_context->rayOrigins ? &user_context->rayOrigins[3*size_t(unsigned(ray.id))] : nullptr;
+      ray.org = Vec3fa(xfmPoint (world2local,instance->rebaseOrigin(ray_org,dorg)),ray.tnear());
       ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
       user_context->instID[0] = instance->geomID;
       IntersectContext context(instance->object,user_context);
@@ -72,7 +94,8 @@ namespace embree
         likely(instance->numTimeSteps == 1) ? instance->getWorld2Local() : instance->getWorld2Local(ray.time());
       const Vec3fa ray_org = ray.org;
       const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+      const double* dorg = user_context->rayOrigins ? &user_context->rayOrigins[3*size_t(unsigned(ray.id))] : nullptr;
+      ray.org = Vec3fa(xfmPoint (world2local,instance->rebaseOrigin(ray_org,dorg)),ray.tnear());
       ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
       user_context->instID[0] = instance->geomID;
       IntersectContext context(instance->object,user_context);
@@ -115,7 +138,7 @@ namespace embree
 
       const Vec3vf<N> ray_org = ray.org;
       const Vec3vf<N> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
+      ray.org = xfmPoint (world2local,instance->rebaseOrigin<N>(valid,ray_org,user_context->rayOrigins,ray.id));
       ray.dir = xfmVector(world2local,ray_dir);
       user_context->instID[0] = instance->geomID;
       IntersectContext context(instance->object,user_context); 
@@ -140,7 +163,7 @@ namespace embree
 
       const Vec3vf<N> ray_org = ray.org;
       const Vec3vf<N> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
+      ray.org = xfmPoint (world2local,instance->rebaseOrigin<N>(valid,ray_org,user_context->rayOrigins,ray.id));
       ray.dir = xfmVector(world2local,ray_dir);
       user_context->instID[0] = instance->geomID;
       IntersectContext context(instance->object,user_context);
@@ -29,6 +29,17 @@ namespace embree
       __forceinline void operator() (vfloat<M>& u, vfloat<M>& v) const {}
     };
 
+    /*! Clears all lanes that hit the back face of a geometry with backface culling
+     *  enabled. The hit has to be finalized, as quads flip their normal there. */
+    template<int Mx, int M, typename Hit>
+    __forceinline vbool<Mx> cullBackfaces(const vbool<Mx>& valid_i, const IntersectContext* context, const vint<M>& geomIDs, Hit& hit, const Vec3fa& dir)
+    {
+      vbool<Mx> valid = valid_i;
+      for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m))
+        if (context->scene->get(geomIDs[j])->cullsBackfaces(context->user->flags) && dot(hit.Ng(j),dir) >= 0.0f) clear(valid,j);
+      return valid;
+    }
+
     template<bool filter>
     struct Intersect1Epilog1
     {
@@ -52,9 +63,19 @@ namespace embree
 #if defined(EMBREE_RAY_MASK)
         if ((geometry->mask & ray.mask) == 0) return false;
 #endif
+
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         hit.finalize();
         int instID = context->geomID_to_instID ? context->geomID_to_instID[0] : geomID;
 
+        /* hit collection mode records the hit and rejects it */
+        if (unlikely(context->hasHitCollection())) {
+          context->collectHit(ray.id,ray.tfar,hit.t,hit.Ng,hit.u,hit.v,primID,instID,context->instID);
+          return false;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -104,6 +125,10 @@ namespace embree
 #if defined(EMBREE_RAY_MASK)
         if ((geometry->mask & ray.mask) == 0) return false;
 #endif
+
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         hit.finalize();
         int instID = context->geomID_to_instID ? context->geomID_to_instID[0] : geomID;
 
@@ -149,8 +174,18 @@ namespace embree
         if ((geometry->mask & ray.mask[k]) == 0)
           return false;
 #endif
+
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         hit.finalize();
 
+        /* hit collection mode records the hit and rejects it */
+        if (unlikely(context->hasHitCollection())) {
+          context->collectHit(ray.id[k],ray.tfar[k],hit.t,hit.Ng,hit.u,hit.v,primID,geomID,context->instID);
+          return false;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -205,6 +240,9 @@ namespace embree
           return false;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -243,10 +281,35 @@ namespace embree
         Scene* scene = context->scene;
         vbool<Mx> valid = valid_i;
         if (Mx > M) valid &= (1<<M)-1;
+
+        /* context visibility test */
+        valid = context->cullInvisibleGeometries(valid,geomIDs);
+        if (unlikely(none(valid))) return false;
+
         hit.finalize();
+
+        /* backface culling test */
+        if (unlikely(scene->hasBackfaceCulling(context->user->flags))) {
+          valid = cullBackfaces(valid,context,geomIDs,hit,ray.dir);
+          if (unlikely(none(valid))) return false;
+        }
+
         size_t i = select_min(valid,hit.vt);
         int geomID = geomIDs[i];
         int instID = context->geomID_to_instID ? context->geomID_to_instID[0] : geomID;
+
+        /* hit collection mode records all hits and rejects them */
+        if (unlikely(context->hasHitCollection())) {
+          for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+#if defined(EMBREE_RAY_MASK)
+            if ((scene->get(geomIDs[j])->mask & ray.mask) == 0) continue;
+#endif
+            const Vec2f uv = hit.uv(j);
+            const unsigned instIDj = context->geomID_to_instID ? context->geomID_to_instID[0] : geomIDs[j];
+            context->collectHit(ray.id,ray.tfar,hit.vt[j],hit.Ng(j),uv.x,uv.y,primIDs[j],instIDj,context->instID);
+          }
+          return false;
+        }
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         bool foundhit = false;
@@ -328,11 +391,36 @@ namespace embree
         Scene* scene = context->scene;
         vbool<Mx> valid = valid_i;
         if (Mx > M) valid &= (1<<M)-1;
+
+        /* context visibility test */
+        valid = context->cullInvisibleGeometries(valid,geomIDs);
+        if (unlikely(none(valid))) return false;
+
         hit.finalize();
+
+        /* backface culling test */
+        if (unlikely(scene->hasBackfaceCulling(context->user->flags))) {
+          valid = cullBackfaces(valid,context,geomIDs,hit,ray.dir);
+          if (unlikely(none(valid))) return false;
+        }
+
         size_t i = select_min(valid,hit.vt);
         int geomID = geomIDs[i];
         int instID = context->geomID_to_instID ? context->geomID_to_instID[0] : geomID;
 
+        /* hit collection mode records all hits and rejects them */
+        if (unlikely(context->hasHitCollection())) {
+          for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+#if defined(EMBREE_RAY_MASK)
+            if ((scene->get(geomIDs[j])->mask & ray.mask) == 0) continue;
+#endif
+            const Vec2f uv = hit.uv(j);
+            const unsigned instIDj = context->geomID_to_instID ? context->geomID_to_instID[0] : geomIDs[j];
+            context->collectHit(ray.id,ray.tfar,hit.vt[j],hit.Ng(j),uv.x,uv.y,primIDs[j],instIDj,context->instID);
+          }
+          return false;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         bool foundhit = false;
@@ -403,14 +491,26 @@ namespace embree
       __forceinline bool operator() (const vbool<Mx>& valid_i, Hit& hit) const
       {
         Scene* scene = context->scene;
+        vbool<Mx> valid = valid_i;
+        if (Mx > M) valid &= (1<<M)-1;
+
+        /* context visibility test */
+        valid = context->cullInvisibleGeometries(valid,geomIDs);
+        if (unlikely(none(valid))) return false;
+
+        /* backface culling test */
+        const bool backfaceCulling = scene->hasBackfaceCulling(context->user->flags);
+        if (unlikely(backfaceCulling)) {
+          hit.finalize();
+          valid = cullBackfaces(valid,context,geomIDs,hit,ray.dir);
+          if (unlikely(none(valid))) return false;
+        }
 
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
-        if (unlikely(filter))
+        if (unlikely(filter && !backfaceCulling))
           hit.finalize(); /* called only once */
 
-        vbool<Mx> valid = valid_i;
-        if (Mx > M) valid &= (1<<M)-1;
         size_t m=movemask(valid);
         goto entry;
         while (true)
@@ -480,9 +580,21 @@ namespace embree
         if ((geometry->mask & ray.mask) == 0) return false;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         vbool<M> valid = valid_i;
         hit.finalize();
 
+        /* hit collection mode records all hits and rejects them */
+        if (unlikely(context->hasHitCollection())) {
+          for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+            const Vec2f uv = hit.uv(j);
+            context->collectHit(ray.id,ray.tfar,hit.vt[j],hit.Ng(j),uv.x,uv.y,primID,geomID,context->instID);
+          }
+          return false;
+        }
+
         size_t i = select_min(valid,hit.vt);
 
         /* intersection filter test */
@@ -549,6 +661,9 @@ namespace embree
         if ((geometry->mask & ray.mask) == 0) return false;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (unlikely(context->hasContextFilter() || geometry->hasOcclusionFilter()))
@@ -607,6 +722,22 @@ namespace embree
         if (unlikely(none(valid))) return false;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
+        /* backface culling test */
+        if (unlikely(geometry->cullsBackfaces(context->user->flags))) {
+          valid &= dot(Ng,ray.dir) < 0.0f;
+          if (unlikely(none(valid))) return false;
+        }
+
+        /* hit collection mode records all hits and rejects them */
+        if (unlikely(context->hasHitCollection())) {
+          for (size_t m=movemask(valid), k=__bsf(m); m!=0; m=__btc(m,k), k=__bsf(m))
+            context->collectHit(ray.id[k],ray.tfar[k],t[k],Vec3fa(Ng.x[k],Ng.y[k],Ng.z[k]),u[k],v[k],primID,geomID,context->instID);
+          return false;
+        }
+
         /* occlusion filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -668,6 +799,15 @@ namespace embree
         if (unlikely(none(valid))) return valid;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
+        /* backface culling test */
+        if (unlikely(geometry->cullsBackfaces(context->user->flags))) {
+          valid &= dot(std::get<3>(hit()),ray.dir) < 0.0f;
+          if (unlikely(none(valid))) return valid;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -722,6 +862,16 @@ namespace embree
         if (unlikely(none(valid))) return false;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
+        /* hit collection mode records all hits and rejects them */
+        if (unlikely(context->hasHitCollection())) {
+          for (size_t m=movemask(valid), k=__bsf(m); m!=0; m=__btc(m,k), k=__bsf(m))
+            context->collectHit(ray.id[k],ray.tfar[k],t[k],Vec3fa(Ng.x[k],Ng.y[k],Ng.z[k]),u[k],v[k],primID,geomID,context->instID);
+          return false;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -778,6 +928,9 @@ namespace embree
         if (unlikely(none(valid))) return false;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         /* occlusion filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
@@ -821,12 +974,36 @@ namespace embree
       {
         Scene* scene = context->scene;
         vbool<Mx> valid = valid_i;
-        hit.finalize();
         if (Mx > M) valid &= (1<<M)-1;
+
+        /* context visibility test */
+        valid = context->cullInvisibleGeometries(valid,geomIDs);
+        if (unlikely(none(valid))) return false;
+
+        hit.finalize();
+
+        /* backface culling test */
+        if (unlikely(scene->hasBackfaceCulling(context->user->flags))) {
+          valid = cullBackfaces(valid,context,geomIDs,hit,Vec3fa(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]));
+          if (unlikely(none(valid))) return false;
+        }
+
         size_t i = select_min(valid,hit.vt);
         assert(i<M);
         int geomID = geomIDs[i];
 
+        /* hit collection mode records all hits and rejects them */
+        if (unlikely(context->hasHitCollection())) {
+          for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+#if defined(EMBREE_RAY_MASK)
+            if ((scene->get(geomIDs[j])->mask & ray.mask[k]) == 0) continue;
+#endif
+            const Vec2f uv = hit.uv(j);
+            context->collectHit(ray.id[k],ray.tfar[k],hit.vt[j],hit.Ng(j),uv.x,uv.y,primIDs[j],geomIDs[j],context->instID);
+          }
+          return false;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         bool foundhit = false;
@@ -909,14 +1086,26 @@ namespace embree
       __forceinline bool operator() (const vbool<Mx>& valid_i, Hit& hit) const
       {
         Scene* scene = context->scene;
+        vbool<Mx> valid = valid_i;
+        if (Mx > M) valid &= (1<<M)-1;
+
+        /* context visibility test */
+        valid = context->cullInvisibleGeometries(valid,geomIDs);
+        if (unlikely(none(valid))) return false;
+
+        /* backface culling test */
+        const bool backfaceCulling = scene->hasBackfaceCulling(context->user->flags);
+        if (unlikely(backfaceCulling)) {
+          hit.finalize();
+          valid = cullBackfaces(valid,context,geomIDs,hit,Vec3fa(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]));
+          if (unlikely(none(valid))) return false;
+        }
 
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
-        if (unlikely(filter))
+        if (unlikely(filter && !backfaceCulling))
           hit.finalize(); /* called only once */
 
-        vbool<Mx> valid = valid_i;
-        if (Mx > M) valid &= (1<<M)-1;
         size_t m=movemask(valid);
         goto entry;
         while (true)
@@ -985,9 +1174,21 @@ namespace embree
           return false;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         /* finalize hit calculation */
         vbool<M> valid = valid_i;
         hit.finalize();
+
+        /* hit collection mode records all hits and rejects them */
+        if (unlikely(context->hasHitCollection())) {
+          for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+            const Vec2f uv = hit.uv(j);
+            context->collectHit(ray.id[k],ray.tfar[k],hit.vt[j],hit.Ng(j),uv.x,uv.y,primID,geomID,context->instID);
+          }
+          return false;
+        }
         size_t i = select_min(valid,hit.vt);
 
         /* intersection filter test */
@@ -1063,6 +1264,9 @@ namespace embree
           return false;
 #endif
 
+        /* context visibility test */
+        if (unlikely(!context->isGeometryVisible(geomID))) return false;
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
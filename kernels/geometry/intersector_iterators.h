@@ -18,6 +18,7 @@
 
 #include "../common/scene.h"
 #include "../common/ray.h"
+#include "../common/point_query.h"
 
 namespace embree
 {
@@ -44,6 +45,14 @@ namespace embree
           return false;
         }
 
+        static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t num)
+        {
+          bool changed = false;
+          for (size_t i=0; i<num; i++)
+            changed |= Intersector::pointQuery(query,context,prim[i]);
+          return changed;
+        }
+
         template<int K>
         static __forceinline void intersectK(const vbool<K>& valid, /* PrecalculationsK& pre, */ RayHitK<K>& ray, IntersectContext* context, const Primitive* prim, size_t num, size_t& lazy_node)
         {
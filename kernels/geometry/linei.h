@@ -265,9 +265,8 @@ namespace embree
     const LineSegments* geom1 = scene->get<LineSegments>(geomID(1));
     const LineSegments* geom2 = scene->get<LineSegments>(geomID(2));
     const LineSegments* geom3 = scene->get<LineSegments>(geomID(3));
-    const vfloat4 numTimeSegments(geom0->fnumTimeSegments, geom1->fnumTimeSegments, geom2->fnumTimeSegments, geom3->fnumTimeSegments);
     vfloat4 ftime;
-    const vint4 itime = getTimeSegment(vfloat4(time), numTimeSegments, ftime);
+    const vint4 itime(geom0->timeSegment(time, ftime[0]), geom1->timeSegment(time, ftime[1]), geom2->timeSegment(time, ftime[2]), geom3->timeSegment(time, ftime[3]));
 
     Vec4vf4 a0,a1;
     gather(a0,a1,geom0,geom1,geom2,geom3,itime);
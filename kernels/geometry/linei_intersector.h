@@ -19,6 +19,7 @@
 #include "linei.h"
 #include "line_intersector.h"
 #include "intersector_epilog.h"
+#include "point_query_intersector.h"
 
 namespace embree
 {
@@ -45,6 +46,13 @@ namespace embree
         const vbool<Mx> valid = line.template valid<Mx>();
         return LineIntersector1<Mx>::intersect(valid,ray,pre,v0,v1,Occluded1EpilogM<M,Mx,filter>(ray,context,line.geomID(),line.primID()));
       }
+
+      /*! Computes the closest point on the M line segments. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& line)
+      {
+        Vec4vf<M> v0,v1; line.gather(v0,v1,context->scene);
+        return pointQueryLines<M>(query,context,line.valid(),v0,v1,vfloat<M>(zero),vfloat<M>(one),line.geomID(),line.primID());
+      }
     };
 
     template<int M, int Mx, bool filter>
@@ -68,6 +76,13 @@ namespace embree
         const vbool<Mx> valid = line.template valid<Mx>();
         return LineIntersector1<Mx>::intersect(valid,ray,pre,v0,v1,Occluded1EpilogM<M,Mx,filter>(ray,context,line.geomID(),line.primID()));
       }
+
+      /*! Computes the closest point on the M line segments. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& line)
+      {
+        Vec4vf<M> v0,v1; line.gather(v0,v1,context->scene,query->time);
+        return pointQueryLines<M>(query,context,line.valid(),v0,v1,vfloat<M>(zero),vfloat<M>(one),line.geomID(),line.primID());
+      }
     };
 
     template<int M, int Mx, int K, bool filter>
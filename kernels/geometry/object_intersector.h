@@ -18,6 +18,7 @@
 
 #include "object.h"
 #include "../common/ray.h"
+#include "point_query_intersector.h"
 
 namespace embree
 {
@@ -45,6 +46,10 @@ namespace embree
           return;
 #endif
 
+        /* perform context visibility test */
+        if (unlikely(!context->isGeometryVisible(prim.geomID())))
+          return;
+
         accel->intersect(ray,prim.primID(),context,reportIntersection1);
       }
       
@@ -57,9 +62,20 @@ namespace embree
           return false;
 #endif
 
+        /* perform context visibility test */
+        if (unlikely(!context->isGeometryVisible(prim.geomID())))
+          return false;
+
         accel->occluded(ray,prim.primID(),context,&reportOcclusion1);
         return ray.tfar < 0.0f;
       }
+
+      /*! Passes the point query to the user callback. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        AccelSet* accel = (AccelSet*) context->scene->get(prim.geomID());
+        return context->callback(query,accel->getUserData(),prim.geomID(),prim.primID());
+      }
       
       template<int K>
       static __forceinline void intersectK(const vbool<K>& valid, /* PrecalculationsK& pre, */ RayHitK<K>& ray, IntersectContext* context, const Primitive* prim, size_t num, size_t& lazy_node)
@@ -94,6 +110,11 @@ namespace embree
         valid &= (ray.mask & accel->mask) != 0;
         if (none(valid)) return;
 #endif
+
+        /* perform context visibility test */
+        if (unlikely(!context->isGeometryVisible(prim.geomID())))
+          return;
+
         accel->intersect(valid,ray,prim.primID(),context,&reportIntersection1);
       }
 
@@ -107,6 +128,11 @@ namespace embree
         valid &= (ray.mask & accel->mask) != 0;
         if (none(valid)) return false;
 #endif
+
+        /* perform context visibility test */
+        if (unlikely(!context->isGeometryVisible(prim.geomID())))
+          return false;
+
         accel->occluded(valid,ray,prim.primID(),context,&reportOcclusion1);
         return ray.tfar < 0.0f;
       }
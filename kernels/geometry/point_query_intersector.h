@@ -0,0 +1,151 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../common/point_query.h"
+
+/*! Closest point kernels used by the point query traversal. All
+ *  kernels compute the closest points of M primitives in SIMD and
+ *  update the query with the closest one inside the query sphere. */
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Computes the closest points on M line segments a+t*(b-a) and returns the squared distances. */
+    template<int M>
+      __forceinline vfloat<M> closestPointSegment(const Vec3vf<M>& p, const Vec3vf<M>& a, const Vec3vf<M>& b, Vec3vf<M>& q, vfloat<M>& t)
+    {
+      const Vec3vf<M> ab = b-a;
+      const vfloat<M> len2 = dot(ab,ab);
+      t = select(len2 > vfloat<M>(zero), clamp(dot(p-a,ab)/len2,vfloat<M>(zero),vfloat<M>(one)), vfloat<M>(zero));
+      q = a + t*ab;
+      const Vec3vf<M> d = q-p;
+      return dot(d,d);
+    }
+
+    /*! Computes the closest points on M triangles and returns the
+     *  squared distances. The u/v coordinates are the barycentric
+     *  coordinates of the closest point with respect to v1 and v2. */
+    template<int M>
+      __forceinline vfloat<M> closestPointTriangle(const Vec3vf<M>& p, const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, Vec3vf<M>& q, vfloat<M>& u, vfloat<M>& v)
+    {
+      /* barycentric coordinates of the projection onto the triangle plane */
+      const Vec3vf<M> e1 = v1-v0;
+      const Vec3vf<M> e2 = v2-v0;
+      const Vec3vf<M> w  = p-v0;
+      const Vec3vf<M> Ng = cross(e1,e2);
+      const vfloat<M> den = dot(Ng,Ng);
+      const vfloat<M> pu = dot(cross(w,e2),Ng)/den;
+      const vfloat<M> pv = dot(cross(e1,w),Ng)/den;
+      const vbool<M> inside = (den > vfloat<M>(zero)) & (pu >= 0.0f) & (pv >= 0.0f) & (pu+pv <= 1.0f);
+
+      /* closest points on the three edges */
+      Vec3vf<M> q01, q02, q12; vfloat<M> t01, t02, t12;
+      const vfloat<M> d01 = closestPointSegment(p,v0,v1,q01,t01);
+      const vfloat<M> d02 = closestPointSegment(p,v0,v2,q02,t02);
+      const vfloat<M> d12 = closestPointSegment(p,v1,v2,q12,t12);
+
+      const vbool<M> s02 = d02 < d01;
+      vfloat<M> eu = select(s02,vfloat<M>(zero),t01);
+      vfloat<M> ev = select(s02,t02,vfloat<M>(zero));
+      const vbool<M> s12 = d12 < min(d01,d02);
+      eu = select(s12,vfloat<M>(one)-t12,eu);
+      ev = select(s12,t12,ev);
+
+      u = select(inside,pu,eu);
+      v = select(inside,pv,ev);
+      q = v0 + u*e1 + v*e2;
+      const Vec3vf<M> d = q-p;
+      return dot(d,d);
+    }
+
+    /*! Updates the query with the closest of the valid primitives if it lies inside the query sphere. */
+    template<int M>
+      __forceinline bool closestPointUpdate(PointQuery* query, PointQueryContext* context, const vbool<M>& valid_i, const vfloat<M>& dist, const Vec3vf<M>& q,
+                                            const vfloat<M>& u, const vfloat<M>& v, const vint<M>& geomID, const vint<M>& primID)
+    {
+      const vbool<M> valid = valid_i & (dist <= vfloat<M>(query->radius));
+      if (none(valid)) return false;
+      const size_t i = select_min(valid,dist);
+      context->update(query,dist[i],Vec3fa(q.x[i],q.y[i],q.z[i]),u[i],v[i],geomID[i],primID[i]);
+      return true;
+    }
+
+    /*! Closest point query for M triangles. */
+    template<int M>
+      __forceinline bool pointQueryTriangles(PointQuery* query, PointQueryContext* context, const vbool<M>& valid,
+                                             const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const vint<M>& geomID, const vint<M>& primID)
+    {
+      Vec3vf<M> q; vfloat<M> u, v;
+      const Vec3vf<M> p(query->x,query->y,query->z);
+      const vfloat<M> dist = sqrt(closestPointTriangle(p,v0,v1,v2,q,u,v));
+      return closestPointUpdate(query,context,valid,dist,q,u,v,geomID,primID);
+    }
+
+    /*! Closest point query for M quads, which are split into the triangles (v0,v1,v3) and (v2,v3,v1). */
+    template<int M>
+      __forceinline bool pointQueryQuads(PointQuery* query, PointQueryContext* context, const vbool<M>& valid,
+                                         const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3, const vint<M>& geomID, const vint<M>& primID)
+    {
+      const Vec3vf<M> p(query->x,query->y,query->z);
+      Vec3vf<M> q0, q1; vfloat<M> u0, v0_, u1, v1_;
+      const vfloat<M> d0 = closestPointTriangle(p,v0,v1,v3,q0,u0,v0_);
+      const vfloat<M> d1 = closestPointTriangle(p,v2,v3,v1,q1,u1,v1_);
+      const vbool<M> second = d1 < d0;
+      const Vec3vf<M> q(select(second,q1.x,q0.x),select(second,q1.y,q0.y),select(second,q1.z,q0.z));
+      const vfloat<M> u = select(second,vfloat<M>(one)-u1,u0);
+      const vfloat<M> v = select(second,vfloat<M>(one)-v1_,v0_);
+      const vfloat<M> dist = sqrt(min(d0,d1));
+      return closestPointUpdate(query,context,valid,dist,q,u,v,geomID,primID);
+    }
+
+    /*! Closest point query for M round line segments, the w component of the vertices stores the radius. */
+    template<int M>
+      __forceinline bool pointQueryLines(PointQuery* query, PointQueryContext* context, const vbool<M>& valid,
+                                         const Vec4vf<M>& a, const Vec4vf<M>& b, const vfloat<M>& u0, const vfloat<M>& du, const vint<M>& geomID, const vint<M>& primID)
+    {
+      const Vec3vf<M> p(query->x,query->y,query->z);
+      Vec3vf<M> c; vfloat<M> t;
+      const vfloat<M> len = sqrt(closestPointSegment(p,Vec3vf<M>(a.x,a.y,a.z),Vec3vf<M>(b.x,b.y,b.z),c,t));
+      const vfloat<M> r = max(madd(t,b.w-a.w,a.w),vfloat<M>(zero));
+
+      /* move the closest point on the center line to the surface */
+      const vbool<M> outside = len > r;
+      const vfloat<M> s = select(outside,r/len,vfloat<M>(one));
+      const Vec3vf<M> q = c + s*(p-c);
+      const vfloat<M> dist = select(outside,len-r,vfloat<M>(zero));
+      return closestPointUpdate(query,context,valid,dist,q,madd(t,du,u0),vfloat<M>(zero),geomID,primID);
+    }
+
+    /*! Closest point query for a cubic curve, approximated by 8 linear segments. */
+    template<typename Curve>
+      __forceinline bool pointQueryCurve(PointQuery* query, PointQueryContext* context, const Curve& curve, const unsigned geomID, const unsigned primID)
+    {
+      const float du = 1.0f/8.0f;
+      bool changed = false;
+      for (int ofs=0; ofs<8; ofs+=4)
+      {
+        const Vec4vf4 a = curve.template eval0<4>(ofs,8);
+        const Vec4vf4 b = curve.template eval1<4>(ofs,8);
+        const vfloat4 u0 = (vfloat4(step)+vfloat4(float(ofs)))*du;
+        changed |= pointQueryLines(query,context,vbool4(true),a,b,u0,vfloat4(du),vint4(geomID),vint4(primID));
+      }
+      return changed;
+    }
+  }
+}
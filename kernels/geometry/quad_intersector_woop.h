@@ -0,0 +1,112 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "triangle_intersector_woop.h"
+
+/*! Watertight ray/quad intersector. The quad is split into the
+ *  triangles (v0,v1,v3) and (v2,v3,v1) that get intersected with the
+ *  watertight Woop triangle test. As both triangles evaluate the
+ *  diagonal from the same transformed vertices, rays cannot leak
+ *  through the diagonal either. */
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Maps the barycentric coordinates of the second quad triangle to quad coordinates. */
+    template<int M>
+    struct UVFlipQuad {
+      __forceinline void operator() (vfloat<M>& u, vfloat<M>& v) const {
+        u = vfloat<M>(one)-u;
+        v = vfloat<M>(one)-v;
+      }
+    };
+
+    /*! Intersects M quads with 1 ray */
+    template<int M, bool filter>
+    struct QuadMIntersector1Woop : public WoopIntersector1<M>
+    {
+      __forceinline QuadMIntersector1Woop() {}
+
+      __forceinline QuadMIntersector1Woop(const Ray& ray, const void* ptr)
+        : WoopIntersector1<M>(ray,ptr) {}
+
+      __forceinline void intersect(RayHit& ray, IntersectContext* context,
+                                   const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3,
+                                   const vint<M>& geomID, const vint<M>& primID) const
+      {
+        Intersect1EpilogM<M,M,filter> epilog(ray,context,geomID,primID);
+        WoopIntersector1<M>::intersect(ray,v0,v1,v3,UVIdentity<M>(),epilog);
+        WoopIntersector1<M>::intersect(ray,v2,v3,v1,UVFlipQuad<M>(),epilog);
+      }
+
+      __forceinline bool occluded(Ray& ray, IntersectContext* context,
+                                  const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3,
+                                  const vint<M>& geomID, const vint<M>& primID) const
+      {
+        Occluded1EpilogM<M,M,filter> epilog(ray,context,geomID,primID);
+        if (WoopIntersector1<M>::intersect(ray,v0,v1,v3,UVIdentity<M>(),epilog)) return true;
+        if (WoopIntersector1<M>::intersect(ray,v2,v3,v1,UVFlipQuad<M>(),epilog)) return true;
+        return false;
+      }
+    };
+
+    /*! Intersects M quads with K rays */
+    template<int M, int K, bool filter>
+    struct QuadMIntersectorKWoop : public WoopIntersectorK<M,K>
+    {
+      __forceinline QuadMIntersectorKWoop(const vbool<K>& valid, const RayK<K>& ray)
+        : WoopIntersectorK<M,K>(valid,ray) {}
+
+      /*! Intersects K rays with one of M quads. */
+      template<typename Epilog>
+      __forceinline bool intersectK(const vbool<K>& valid0,
+                                    RayK<K>& ray,
+                                    const Vec3vf<K>& v0,
+                                    const Vec3vf<K>& v1,
+                                    const Vec3vf<K>& v2,
+                                    const Vec3vf<K>& v3,
+                                    const Epilog& epilog) const
+      {
+        WoopIntersectorK<M,K>::intersectK(valid0,ray,v0,v1,v3,UVIdentity<K>(),epilog);
+        if (none(valid0)) return true;
+        WoopIntersectorK<M,K>::intersectK(valid0,ray,v2,v3,v1,UVFlipQuad<K>(),epilog);
+        return none(valid0);
+      }
+
+      __forceinline void intersect1(RayHitK<K>& ray, size_t k, IntersectContext* context,
+                                    const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3,
+                                    const vint<M>& geomID, const vint<M>& primID) const
+      {
+        Intersect1KEpilogM<M,M,K,filter> epilog(ray,k,context,geomID,primID);
+        WoopIntersectorK<M,K>::intersect(ray,k,v0,v1,v3,UVIdentity<M>(),epilog);
+        WoopIntersectorK<M,K>::intersect(ray,k,v2,v3,v1,UVFlipQuad<M>(),epilog);
+      }
+
+      __forceinline bool occluded1(RayK<K>& ray, size_t k, IntersectContext* context,
+                                   const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3,
+                                   const vint<M>& geomID, const vint<M>& primID) const
+      {
+        Occluded1KEpilogM<M,M,K,filter> epilog(ray,k,context,geomID,primID);
+        if (WoopIntersectorK<M,K>::intersect(ray,k,v0,v1,v3,UVIdentity<M>(),epilog)) return true;
+        if (WoopIntersectorK<M,K>::intersect(ray,k,v2,v3,v1,UVFlipQuad<M>(),epilog)) return true;
+        return false;
+      }
+    };
+  }
+}
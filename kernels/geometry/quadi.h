@@ -142,7 +142,7 @@ namespace embree
       const QuadMesh* mesh = scene->get<QuadMesh>(geomID(index));
 
       vfloat<K> ftime;
-      const vint<K> itime = getTimeSegment(time, vfloat<K>(mesh->fnumTimeSegments), ftime);
+      const vint<K> itime = mesh->timeSegment(time, ftime);
 
       const size_t first = __bsf(movemask(valid));
       if (likely(all(valid,itime[first] == itime)))
@@ -445,9 +445,8 @@ namespace embree
     const QuadMesh* mesh2 = scene->get<QuadMesh>(geomID(2));
     const QuadMesh* mesh3 = scene->get<QuadMesh>(geomID(3));
 
-    const vfloat4 numTimeSegments(mesh0->fnumTimeSegments, mesh1->fnumTimeSegments, mesh2->fnumTimeSegments, mesh3->fnumTimeSegments);
     vfloat4 ftime;
-    const vint4 itime = getTimeSegment(vfloat4(time), numTimeSegments, ftime);
+    const vint4 itime(mesh0->timeSegment(time, ftime[0]), mesh1->timeSegment(time, ftime[1]), mesh2->timeSegment(time, ftime[2]), mesh3->timeSegment(time, ftime[3]));
 
     Vec3vf4 a0,a1,a2,a3; gather(a0,a1,a2,a3,mesh0,mesh1,mesh2,mesh3,itime);
     Vec3vf4 b0,b1,b2,b3; gather(b0,b1,b2,b3,mesh0,mesh1,mesh2,mesh3,itime+1);
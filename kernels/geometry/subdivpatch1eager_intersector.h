@@ -21,6 +21,7 @@
 #include "grid_soa_intersector1.h"
 #include "grid_soa_intersector_packet.h"
 #include "../common/ray.h"
+#include "../common/point_query.h"
 
 namespace embree
 {
@@ -74,6 +75,11 @@ namespace embree
       static __forceinline bool occluded(Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty0, const Primitive* prim, size_t ty, size_t& lazy_node) {
         return occluded(pre,ray,context,prim,ty,lazy_node);
       }
+
+      /*! Point queries are not supported for subdivision surfaces. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t ty) {
+        return false;
+      }
     };
 
     class SubdivPatch1EagerMBIntersector1
@@ -112,6 +118,11 @@ namespace embree
       static __forceinline bool occluded(Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty0, const Primitive* prim, size_t ty, size_t& lazy_node) {
         return occluded(pre,ray,context,prim,ty,lazy_node);
       }
+
+      /*! Point queries are not supported for subdivision surfaces. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t ty) {
+        return false;
+      }
     };
 
     template <int K>
@@ -18,6 +18,7 @@
 
 #include "triangle.h"
 #include "triangle_intersector_moeller.h"
+#include "point_query_intersector.h"
 
 namespace embree
 {
@@ -43,6 +44,12 @@ namespace embree
           STAT3(shadow.trav_prims,1,1,1);
           return pre.intersectEdge(ray,tri.v0,tri.e1,tri.e2,Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID()));
         }
+
+        /*! Computes the closest point on the M triangles. */
+        static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const TriangleM<M>& tri)
+        {
+          return pointQueryTriangles<M>(query,context,tri.valid(),tri.v0,tri.v0-tri.e1,tri.v0+tri.e2,tri.geomID(),tri.primID());
+        }
       };
 
 #if defined(__AVX__)
@@ -67,6 +74,12 @@ namespace embree
           STAT3(shadow.trav_prims,1,1,1);
           return pre.intersect(ray,tri.v0,tri.e1,tri.e2,Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID()));
         }
+
+        /*! Computes the closest point on the M triangles. */
+        static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const TriangleM<M>& tri)
+        {
+          return pointQueryTriangles<M>(query,context,tri.valid(),tri.v0,tri.v0-tri.e1,tri.v0+tri.e2,tri.geomID(),tri.primID());
+        }
       };
 #endif
 
@@ -0,0 +1,308 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "triangle.h"
+#include "intersector_epilog.h"
+
+/*! Watertight ray/triangle intersector after Woop, Benthin and Wald
+ *  2013. A permutation and shear that maps the ray direction onto the
+ *  +z axis is precalculated once per ray. The triangle vertices are
+ *  transformed into that ray space and the ray is tested against the
+ *  2D edge functions of the projected triangle. Edge functions close
+ *  to zero are recalculated in double precision, thus neighboring
+ *  triangles always agree on the side of a shared edge a ray passes
+ *  and no ray can leak between them. */
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Calculates the 2D edge function ax*by-ay*bx. Results that are
+     *  within the rounding error of the two products get recalculated
+     *  with exact products in double precision. */
+    template<int M>
+      __forceinline vfloat<M> woop_edge_function(const vfloat<M>& ax, const vfloat<M>& ay, const vfloat<M>& bx, const vfloat<M>& by)
+    {
+      const vfloat<M> p0 = ax*by;
+      const vfloat<M> p1 = ay*bx;
+      vfloat<M> e = p0-p1;
+      const vbool<M> uncertain = abs(e) <= vfloat<M>(4.0f*float(ulp))*(abs(p0)+abs(p1));
+      if (unlikely(any(uncertain)))
+      {
+        size_t mask = movemask(uncertain);
+        while (mask) {
+          const size_t i = __bscf(mask);
+          e[i] = float(double(ax[i])*double(by[i]) - double(ay[i])*double(bx[i]));
+        }
+      }
+      return e;
+    }
+
+    /*! Performs the edge and depth tests for vertices in ray space. */
+    template<int M>
+      __forceinline vbool<M> woop_intersect(vbool<M> valid,
+                                            const vfloat<M>& Ax, const vfloat<M>& Ay, const vfloat<M>& Az,
+                                            const vfloat<M>& Bx, const vfloat<M>& By, const vfloat<M>& Bz,
+                                            const vfloat<M>& Cx, const vfloat<M>& Cy, const vfloat<M>& Cz,
+                                            const vfloat<M>& tnear, const vfloat<M>& tfar,
+                                            vfloat<M>& V, vfloat<M>& W, vfloat<M>& T, vfloat<M>& det)
+    {
+      /* perform edge tests */
+      const vfloat<M> U = woop_edge_function(Cx,Cy,Bx,By);
+      V = woop_edge_function(Ax,Ay,Cx,Cy);
+      W = woop_edge_function(Bx,By,Ax,Ay);
+#if defined(EMBREE_BACKFACE_CULLING)
+      valid &= min(U,V,W) >= 0.0f;
+#else
+      valid &= (min(U,V,W) >= 0.0f) | (max(U,V,W) <= 0.0f);
+#endif
+      if (unlikely(none(valid))) return valid;
+
+      /* avoid division by 0 */
+      det = U+V+W;
+      valid &= det != vfloat<M>(zero);
+      if (unlikely(none(valid))) return valid;
+
+      /* perform depth test */
+      const vfloat<M> absDet = abs(det);
+      const vfloat<M> sgnDet = signmsk(det);
+      T = U*Az + V*Bz + W*Cz;
+      valid &= absDet*tnear < (T^sgnDet);
+      valid &= (T^sgnDet) <= absDet*tfar;
+      return valid;
+    }
+
+    template<int M, typename UVMapper>
+      struct WoopHitM
+    {
+      __forceinline WoopHitM(const vfloat<M>& V, const vfloat<M>& W, const vfloat<M>& T, const vfloat<M>& det, const Vec3vf<M>& Ng, const UVMapper& mapUV)
+        : V(V), W(W), T(T), det(det), mapUV(mapUV), vNg(Ng) {}
+
+      __forceinline void finalize()
+      {
+        const vfloat<M> rcpDet = rcp(det);
+        vt = T * rcpDet;
+        vu = V * rcpDet;
+        vv = W * rcpDet;
+        mapUV(vu,vv);
+      }
+
+      __forceinline Vec2f uv (const size_t i) const { return Vec2f(vu[i],vv[i]); }
+      __forceinline float t  (const size_t i) const { return vt[i]; }
+      __forceinline Vec3fa Ng(const size_t i) const { return Vec3fa(vNg.x[i],vNg.y[i],vNg.z[i]); }
+
+    private:
+      const vfloat<M> V;
+      const vfloat<M> W;
+      const vfloat<M> T;
+      const vfloat<M> det;
+      const UVMapper& mapUV;
+
+    public:
+      vfloat<M> vu;
+      vfloat<M> vv;
+      vfloat<M> vt;
+      Vec3vf<M> vNg;
+    };
+
+    template<int M>
+      struct WoopIntersector1
+      {
+        __forceinline WoopIntersector1() {}
+
+        __forceinline WoopIntersector1(const Ray& ray, const void* ptr)
+        {
+          /* the largest direction component becomes the z axis, swapping x and y keeps the winding */
+          kz = maxDim(abs(ray.dir));
+          kx = (kz+1) % 3;
+          ky = (kx+1) % 3;
+          if (ray.dir[kz] < 0.0f) std::swap(kx,ky);
+
+          /* shear that maps the ray direction onto the z axis */
+          Sz = 1.0f/ray.dir[kz];
+          Sx = ray.dir[kx]*Sz;
+          Sy = ray.dir[ky]*Sz;
+        }
+
+        template<typename UVMapper, typename Epilog>
+          __forceinline bool intersect(Ray& ray,
+                                       const Vec3vf<M>& tri_v0,
+                                       const Vec3vf<M>& tri_v1,
+                                       const Vec3vf<M>& tri_v2,
+                                       const UVMapper& mapUV,
+                                       const Epilog& epilog) const
+        {
+          /* calculate vertices relative to ray origin */
+          const Vec3vf<M> O = Vec3vf<M>(ray.org);
+          const Vec3vf<M> A = tri_v0-O;
+          const Vec3vf<M> B = tri_v1-O;
+          const Vec3vf<M> C = tri_v2-O;
+
+          /* shear and scale vertices into ray space */
+          const vfloat<M> Ax = A[kx] - Sx*A[kz];
+          const vfloat<M> Ay = A[ky] - Sy*A[kz];
+          const vfloat<M> Bx = B[kx] - Sx*B[kz];
+          const vfloat<M> By = B[ky] - Sy*B[kz];
+          const vfloat<M> Cx = C[kx] - Sx*C[kz];
+          const vfloat<M> Cy = C[ky] - Sy*C[kz];
+          const vfloat<M> Az = Sz*A[kz];
+          const vfloat<M> Bz = Sz*B[kz];
+          const vfloat<M> Cz = Sz*C[kz];
+
+          /* perform edge and depth tests */
+          vfloat<M> V,W,T,det;
+          const vbool<M> valid = woop_intersect(vbool<M>(true),Ax,Ay,Az,Bx,By,Bz,Cx,Cy,Cz,vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),V,W,T,det);
+          if (unlikely(none(valid))) return false;
+
+          /* update hit information */
+          const Vec3vf<M> Ng = stable_triangle_normal(C-A,A-B,B-C);
+          WoopHitM<M,UVMapper> hit(V,W,T,det,Ng,mapUV);
+          return epilog(valid,hit);
+        }
+
+      private:
+        int kx, ky, kz;  //!< permutation of the coordinate axes
+        float Sx, Sy, Sz; //!< shear and scale along the z axis
+      };
+
+    template<int K, typename UVMapper>
+      struct WoopHitK
+    {
+      __forceinline WoopHitK(const vfloat<K>& V, const vfloat<K>& W, const vfloat<K>& T, const vfloat<K>& det, const Vec3vf<K>& Ng, const UVMapper& mapUV)
+        : V(V), W(W), T(T), det(det), Ng(Ng), mapUV(mapUV) {}
+
+      __forceinline std::tuple<vfloat<K>,vfloat<K>,vfloat<K>,Vec3vf<K>> operator() () const
+      {
+        const vfloat<K> rcpDet = rcp(det);
+        const vfloat<K> t = T * rcpDet;
+        vfloat<K> u = V * rcpDet;
+        vfloat<K> v = W * rcpDet;
+        mapUV(u,v);
+        return std::make_tuple(u,v,t,Ng);
+      }
+
+    private:
+      const vfloat<K> V;
+      const vfloat<K> W;
+      const vfloat<K> T;
+      const vfloat<K> det;
+      const Vec3vf<K> Ng;
+      const UVMapper& mapUV;
+    };
+
+    template<int M, int K>
+      struct WoopIntersectorK
+      {
+        __forceinline WoopIntersectorK(const vbool<K>& valid, const RayK<K>& ray)
+        {
+          /* permutation of the coordinate axes per ray */
+          const Vec3vf<K> adir = abs(ray.dir);
+          const vint<K> kz = select((adir.x > adir.y) & (adir.x > adir.z), vint<K>(0), select(adir.y > adir.z, vint<K>(1), vint<K>(2)));
+          const vint<K> kx0 = select(kz == vint<K>(2), vint<K>(0), kz+1);
+          const vint<K> ky0 = select(kx0 == vint<K>(2), vint<K>(0), kx0+1);
+          const vfloat<K> dirz = select(kz == vint<K>(0), ray.dir.x, select(kz == vint<K>(1), ray.dir.y, ray.dir.z));
+          const vbool<K> flip = dirz < 0.0f;
+          const vint<K> kx = select(flip, ky0, kx0);
+          const vint<K> ky = select(flip, kx0, ky0);
+
+          /* shear that maps the ray direction onto the z axis */
+          const vfloat<K> Sz = select(valid, vfloat<K>(one)/dirz, vfloat<K>(zero));
+          const vfloat<K> Sx = select(kx == vint<K>(0), ray.dir.x, select(kx == vint<K>(1), ray.dir.y, ray.dir.z))*Sz;
+          const vfloat<K> Sy = select(ky == vint<K>(0), ray.dir.x, select(ky == vint<K>(1), ray.dir.y, ray.dir.z))*Sz;
+
+          /* store the transformation as matrix rows, as the permutation differs between rays */
+          for (size_t i=0; i<3; i++)
+          {
+            const vint<K> ci((int)i);
+            shx[i] = select(kx == ci, vfloat<K>(one), vfloat<K>(zero)) - select(kz == ci, Sx, vfloat<K>(zero));
+            shy[i] = select(ky == ci, vfloat<K>(one), vfloat<K>(zero)) - select(kz == ci, Sy, vfloat<K>(zero));
+            shz[i] = select(kz == ci, Sz, vfloat<K>(zero));
+          }
+        }
+
+        /*! Intersects K rays with one of M triangles. */
+        template<typename UVMapper, typename Epilog>
+          __forceinline vbool<K> intersectK(const vbool<K>& valid0,
+                                            RayK<K>& ray,
+                                            const Vec3vf<K>& tri_v0,
+                                            const Vec3vf<K>& tri_v1,
+                                            const Vec3vf<K>& tri_v2,
+                                            const UVMapper& mapUV,
+                                            const Epilog& epilog) const
+        {
+          /* calculate vertices relative to ray origin */
+          const Vec3vf<K> O = ray.org;
+          const Vec3vf<K> A = tri_v0-O;
+          const Vec3vf<K> B = tri_v1-O;
+          const Vec3vf<K> C = tri_v2-O;
+
+          /* shear and scale vertices into ray space */
+          const vfloat<K> Ax = dot(shx,A), Ay = dot(shy,A), Az = dot(shz,A);
+          const vfloat<K> Bx = dot(shx,B), By = dot(shy,B), Bz = dot(shz,B);
+          const vfloat<K> Cx = dot(shx,C), Cy = dot(shy,C), Cz = dot(shz,C);
+
+          /* perform edge and depth tests */
+          vfloat<K> V,W,T,det;
+          const vbool<K> valid = woop_intersect(valid0,Ax,Ay,Az,Bx,By,Bz,Cx,Cy,Cz,ray.tnear(),ray.tfar,V,W,T,det);
+          if (unlikely(none(valid))) return false;
+
+          /* calculate hit information */
+          const Vec3vf<K> Ng = stable_triangle_normal(C-A,A-B,B-C);
+          WoopHitK<K,UVMapper> hit(V,W,T,det,Ng,mapUV);
+          return epilog(valid,hit);
+        }
+
+        /*! Intersect k'th ray from ray packet of size K with M triangles. */
+        template<typename UVMapper, typename Epilog>
+          __forceinline bool intersect(RayK<K>& ray, size_t k,
+                                       const Vec3vf<M>& tri_v0,
+                                       const Vec3vf<M>& tri_v1,
+                                       const Vec3vf<M>& tri_v2,
+                                       const UVMapper& mapUV,
+                                       const Epilog& epilog) const
+        {
+          /* calculate vertices relative to ray origin */
+          const Vec3vf<M> O = broadcast<vfloat<M>>(ray.org,k);
+          const Vec3vf<M> A = tri_v0-O;
+          const Vec3vf<M> B = tri_v1-O;
+          const Vec3vf<M> C = tri_v2-O;
+
+          /* shear and scale vertices into ray space, using the same operations as intersectK */
+          const Vec3vf<M> sx = broadcast<vfloat<M>>(shx,k);
+          const Vec3vf<M> sy = broadcast<vfloat<M>>(shy,k);
+          const Vec3vf<M> sz = broadcast<vfloat<M>>(shz,k);
+          const vfloat<M> Ax = dot(sx,A), Ay = dot(sy,A), Az = dot(sz,A);
+          const vfloat<M> Bx = dot(sx,B), By = dot(sy,B), Bz = dot(sz,B);
+          const vfloat<M> Cx = dot(sx,C), Cy = dot(sy,C), Cz = dot(sz,C);
+
+          /* perform edge and depth tests */
+          vfloat<M> V,W,T,det;
+          const vbool<M> valid = woop_intersect(vbool<M>(true),Ax,Ay,Az,Bx,By,Bz,Cx,Cy,Cz,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),V,W,T,det);
+          if (unlikely(none(valid))) return false;
+
+          /* calculate hit information */
+          const Vec3vf<M> Ng = stable_triangle_normal(C-A,A-B,B-C);
+          WoopHitM<M,UVMapper> hit(V,W,T,det,Ng,mapUV);
+          return epilog(valid,hit);
+        }
+
+      private:
+        Vec3vf<K> shx, shy, shz; //!< rows of the ray space transformation per ray
+      };
+  }
+}
@@ -127,7 +127,7 @@ namespace embree
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
 
       vfloat<K> ftime;
-      const vint<K> itime = getTimeSegment(time, vfloat<K>(mesh->fnumTimeSegments), ftime);
+      const vint<K> itime = mesh->timeSegment(time, ftime);
 
       const size_t first = __bsf(movemask(valid));
       if (likely(all(valid,itime[first] == itime)))
@@ -352,9 +352,8 @@ namespace embree
     const TriangleMesh* mesh2 = scene->get<TriangleMesh>(geomID(2));
     const TriangleMesh* mesh3 = scene->get<TriangleMesh>(geomID(3));
 
-    const vfloat4 numTimeSegments(mesh0->fnumTimeSegments, mesh1->fnumTimeSegments, mesh2->fnumTimeSegments, mesh3->fnumTimeSegments);
     vfloat4 ftime;
-    const vint4 itime = getTimeSegment(vfloat4(time), numTimeSegments, ftime);
+    const vint4 itime(mesh0->timeSegment(time, ftime[0]), mesh1->timeSegment(time, ftime[1]), mesh2->timeSegment(time, ftime[2]), mesh3->timeSegment(time, ftime[3]));
 
     Vec3vf4 a0,a1,a2; gather(a0,a1,a2,mesh0,mesh1,mesh2,mesh3,itime);
     Vec3vf4 b0,b1,b2; gather(b0,b1,b2,mesh0,mesh1,mesh2,mesh3,itime+1);
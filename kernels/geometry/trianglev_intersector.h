@@ -19,6 +19,8 @@
 #include "triangle.h"
 #include "triangle_intersector_pluecker.h"
 #include "triangle_intersector_moeller.h"
+#include "triangle_intersector_woop.h"
+#include "point_query_intersector.h"
 
 namespace embree
 {
@@ -44,6 +46,12 @@ namespace embree
           STAT3(shadow.trav_prims,1,1,1);
           return pre.intersect(ray,tri.v0,tri.v1,tri.v2,/*UVIdentity<Mx>(),*/Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID())); 
         }
+
+        /*! Computes the closest point on the M triangles. */
+        static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
+        {
+          return pointQueryTriangles<M>(query,context,tri.valid(),tri.v0,tri.v1,tri.v2,tri.geomID(),tri.primID());
+        }
       };
 
     /*! Intersects M triangles with K rays */
@@ -120,6 +128,12 @@ namespace embree
           STAT3(shadow.trav_prims,1,1,1);
           return pre.intersect(ray,tri.v0,tri.v1,tri.v2,UVIdentity<Mx>(),Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID())); 
         }
+
+        /*! Computes the closest point on the M triangles. */
+        static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
+        {
+          return pointQueryTriangles<M>(query,context,tri.valid(),tri.v0,tri.v1,tri.v2,tri.geomID(),tri.primID());
+        }
       };
 
     /*! Intersects M triangles with K rays */
@@ -175,5 +189,87 @@ namespace embree
           return pre.intersect(ray,k,tri.v0,tri.v1,tri.v2,UVIdentity<Mx>(),Occluded1KEpilogM<M,Mx,K,filter>(ray,k,context,tri.geomID(),tri.primID())); //FIXME: M,Mx
         }
       };
+
+    /*! Intersects M triangles with 1 ray */
+    template<int M, int Mx, bool filter>
+      struct TriangleMvIntersector1Woop
+      {
+        typedef TriangleMv<M> Primitive;
+        typedef WoopIntersector1<Mx> Precalculations;
+        
+        /*! Intersect a ray with M triangles and updates the hit. */
+        static __forceinline void intersect(Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& tri)
+        {
+          STAT3(normal.trav_prims,1,1,1);
+          pre.intersect(ray,tri.v0,tri.v1,tri.v2,UVIdentity<Mx>(),Intersect1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID())); 
+        }
+        
+        /*! Test if the ray is occluded by one of the M triangles. */
+        static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& tri)
+        {
+          STAT3(shadow.trav_prims,1,1,1);
+          return pre.intersect(ray,tri.v0,tri.v1,tri.v2,UVIdentity<Mx>(),Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID())); 
+        }
+
+        /*! Computes the closest point on the M triangles. */
+        static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
+        {
+          return pointQueryTriangles<M>(query,context,tri.valid(),tri.v0,tri.v1,tri.v2,tri.geomID(),tri.primID());
+        }
+      };
+
+    /*! Intersects M triangles with K rays */
+    template<int M, int Mx, int K, bool filter>
+      struct TriangleMvIntersectorKWoop
+      {
+        typedef TriangleMv<M> Primitive;
+        typedef WoopIntersectorK<Mx,K> Precalculations;
+        
+        /*! Intersects K rays with M triangles. */
+        static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const Primitive& tri)
+        {
+          for (size_t i=0; i<M; i++)
+          {
+            if (!tri.valid(i)) break;
+            STAT3(normal.trav_prims,1,popcnt(valid_i),K);
+            const Vec3vf<K> v0 = broadcast<vfloat<K>>(tri.v0,i);
+            const Vec3vf<K> v1 = broadcast<vfloat<K>>(tri.v1,i);
+            const Vec3vf<K> v2 = broadcast<vfloat<K>>(tri.v2,i);
+            pre.intersectK(valid_i,ray,v0,v1,v2,UVIdentity<K>(),IntersectKEpilogM<M,K,filter>(ray,context,tri.geomID(),tri.primID(),i));
+          }
+        }
+        
+        /*! Test for K rays if they are occluded by any of the M triangles. */
+        static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& tri)
+        {
+          vbool<K> valid0 = valid_i;
+          
+          for (size_t i=0; i<M; i++)
+          {
+            if (!tri.valid(i)) break;
+            STAT3(shadow.trav_prims,1,popcnt(valid_i),K);
+            const Vec3vf<K> v0 = broadcast<vfloat<K>>(tri.v0,i);
+            const Vec3vf<K> v1 = broadcast<vfloat<K>>(tri.v1,i);
+            const Vec3vf<K> v2 = broadcast<vfloat<K>>(tri.v2,i);
+            pre.intersectK(valid0,ray,v0,v1,v2,UVIdentity<K>(),OccludedKEpilogM<M,K,filter>(valid0,ray,context,tri.geomID(),tri.primID(),i));
+            if (none(valid0)) break;
+          }
+          return !valid0;
+        }
+        
+        /*! Intersect a ray with M triangles and updates the hit. */
+        static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive& tri)
+        {
+          STAT3(normal.trav_prims,1,1,1);
+          pre.intersect(ray,k,tri.v0,tri.v1,tri.v2,UVIdentity<Mx>(),Intersect1KEpilogM<M,Mx,K,filter>(ray,k,context,tri.geomID(),tri.primID()));
+        }
+        
+        /*! Test if the ray is occluded by one of the M triangles. */
+        static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& tri)
+        {
+          STAT3(shadow.trav_prims,1,1,1);
+          return pre.intersect(ray,k,tri.v0,tri.v1,tri.v2,UVIdentity<Mx>(),Occluded1KEpilogM<M,Mx,K,filter>(ray,k,context,tri.geomID(),tri.primID()));
+        }
+      };
   }
 }
@@ -165,19 +165,21 @@ namespace embree
         const unsigned geomID = prim.geomID();
         const unsigned primID = prim.primID();
         const TriangleMesh* const mesh = scene->get<TriangleMesh>(geomID);
-        const unsigned numTimeSegments = mesh->numTimeSegments();
-        const range<int> itime_range = getTimeSegmentRange(time_range, (float)numTimeSegments);
+        const int numTimeSegments = int(mesh->numTimeSegments());
+        const range<int> itime_range = mesh->timeSegmentRange(time_range);
         assert(itime_range.size() == 1);
-        const int ilower = itime_range.begin();
+        /* the mesh does not move before its first and after its last time step */
+        const int ilower = clamp(itime_range.begin()+0,0,numTimeSegments);
+        const int iupper = clamp(itime_range.begin()+1,0,numTimeSegments);
         const TriangleMesh::Triangle& tri = mesh->triangle(primID);
         allBounds.extend(mesh->linearBounds(primID, time_range));
-        const Vec3fa& a0 = mesh->vertex(tri.v[0],ilower+0);
-        const Vec3fa& a1 = mesh->vertex(tri.v[0],ilower+1);
-        const Vec3fa& b0 = mesh->vertex(tri.v[1],ilower+0);
-        const Vec3fa& b1 = mesh->vertex(tri.v[1],ilower+1);
-        const Vec3fa& c0 = mesh->vertex(tri.v[2],ilower+0);
-        const Vec3fa& c1 = mesh->vertex(tri.v[2],ilower+1);
-        const BBox1f time_range_v(float(ilower+0)/float(numTimeSegments),float(ilower+1)/float(numTimeSegments));
+        const Vec3fa& a0 = mesh->vertex(tri.v[0],ilower);
+        const Vec3fa& a1 = mesh->vertex(tri.v[0],iupper);
+        const Vec3fa& b0 = mesh->vertex(tri.v[1],ilower);
+        const Vec3fa& b1 = mesh->vertex(tri.v[1],iupper);
+        const Vec3fa& c0 = mesh->vertex(tri.v[2],ilower);
+        const Vec3fa& c1 = mesh->vertex(tri.v[2],iupper);
+        const BBox1f time_range_v = ilower != iupper ? BBox1f(mesh->timeStep(ilower),mesh->timeStep(iupper)) : time_range;
         auto a01 = globalLinear(std::make_pair(a0,a1),time_range_v);
         auto b01 = globalLinear(std::make_pair(b0,b1),time_range_v);
         auto c01 = globalLinear(std::make_pair(c0,c1),time_range_v);
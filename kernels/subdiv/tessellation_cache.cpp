@@ -23,12 +23,13 @@ namespace embree
   __thread ThreadWorkState* SharedLazyTessellationCache::init_t_state = nullptr;
   ThreadWorkState* SharedLazyTessellationCache::current_t_state = nullptr;
 
-  void resizeTessellationCache(size_t new_size)
+  void resizeTessellationCache(size_t new_size, MemoryMonitorInterface* device)
   {    
     if (new_size >= SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE)
       new_size = SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE;
-    if (SharedLazyTessellationCache::sharedLazyTessellationCache.getSize() != new_size) 
-      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size);    
+    if (SharedLazyTessellationCache::sharedLazyTessellationCache.getSize() != new_size ||
+        SharedLazyTessellationCache::sharedLazyTessellationCache.getDevice() != device) 
+      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size,device);
   }
 
   void resetTessellationCache()
@@ -42,6 +43,7 @@ namespace embree
     size = 0;
     data = nullptr;
     hugepages = false;
+    device = nullptr;
     maxBlocks              = size/BLOCK_SIZE;
     localTime              = NUM_CACHE_SEGMENTS;
     next_block             = 0;
@@ -178,7 +180,7 @@ namespace embree
     reset_state.unlock();
   }
 
-  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  void SharedLazyTessellationCache::realloc(const size_t new_size, MemoryMonitorInterface* new_device)
   {
     /* lock the reset_state */
     reset_state.lock();
@@ -192,10 +194,11 @@ namespace embree
         waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
 
     /* reallocate data */
-    if (data) os_free(data,size,hugepages);
+    if (data) device->memoryFree(data,size,true,hugepages);
     size      = new_size;
     data      = nullptr;
-    if (size) data = (float*)os_malloc(size,hugepages);
+    device    = new_device;
+    if (size) data = (float*)device->memoryAlloc(size,PAGE_SIZE,true,hugepages);
     maxBlocks = size/BLOCK_SIZE;    
 
     /* invalidate entire cache */
@@ -47,7 +47,7 @@ namespace embree
     static void clearStats();
   };
   
-  void resizeTessellationCache(size_t new_size);
+  void resizeTessellationCache(size_t new_size, MemoryMonitorInterface* device);
   void resetTessellationCache();
   
  ////////////////////////////////////////////////////////////////////////////////
@@ -143,6 +143,7 @@ namespace embree
    float *data;
    bool hugepages;
    size_t size;
+   MemoryMonitorInterface* device; //!< device the cache memory got allocated through
    size_t maxBlocks;
    ThreadWorkState *threadWorkState;
       
@@ -327,9 +328,10 @@ namespace embree
    __forceinline size_t getNumUsedBytes() { return next_block * BLOCK_SIZE; }
    __forceinline size_t getMaxBlocks()    { return maxBlocks; }
    __forceinline size_t getSize()         { return size; }
+   __forceinline MemoryMonitorInterface* getDevice() { return device; }
 
    void allocNextSegment();
-   void realloc(const size_t newSize);
+   void realloc(const size_t newSize, MemoryMonitorInterface* newDevice);
 
    void reset();
 
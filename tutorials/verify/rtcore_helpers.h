@@ -270,6 +270,7 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
+    ray_o.ray.id[i] = ray_i.ray.id;
     ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
@@ -292,6 +293,7 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
+    ray_o.ray.id[i] = ray_i.ray.id;
     ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
@@ -314,6 +316,7 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
+    ray_o.ray.id[i] = ray_i.ray.id;
     ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
@@ -337,6 +340,7 @@ namespace embree
     RTCRayN_tfar(ray_o,N,i) = ray_i.ray.tfar;
     RTCRayN_time(ray_o,N,i) = ray_i.ray.time;
     RTCRayN_mask(ray_o,N,i) = ray_i.ray.mask;
+    RTCRayN_id(ray_o,N,i) = ray_i.ray.id;
     RTCHitN* hit_o = RTCRayHitN_HitN(rayhit_o,N);
     RTCHitN_instID(hit_o,N,i,0) = ray_i.hit.instID[0];
     RTCHitN_geomID(hit_o,N,i) = ray_i.hit.geomID;
@@ -361,6 +365,7 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
+    ray_o.ray.id = ray_i.ray.id[i];
     ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
@@ -385,6 +390,7 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
+    ray_o.ray.id = ray_i.ray.id[i];
     ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
@@ -409,6 +415,7 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
+    ray_o.ray.id = ray_i.ray.id[i];
     ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
@@ -435,6 +442,7 @@ namespace embree
     ray_o.ray.tfar  = RTCRayN_tfar(ray_i,N,i);
     ray_o.ray.time = RTCRayN_time(ray_i,N,i);
     ray_o.ray.mask = RTCRayN_mask(ray_i,N,i);
+    ray_o.ray.id = RTCRayN_id(ray_i,N,i);
     ray_o.hit.instID[0] = RTCHitN_instID(hit_i,N,i,0);
     ray_o.hit.geomID = RTCHitN_geomID(hit_i,N,i);
     ray_o.hit.primID = RTCHitN_primID(hit_i,N,i);
@@ -578,6 +586,8 @@ namespace embree
     else ret += "Static";
     if (scene_flags & RTC_SCENE_FLAG_COMPACT) ret += "Compact";
     if (scene_flags & RTC_SCENE_FLAG_ROBUST ) ret += "Robust";
+    if (scene_flags & RTC_SCENE_FLAG_WATERTIGHT) ret += "Watertight";
+    if (scene_flags & RTC_SCENE_FLAG_DOUBLE_BUFFERED) ret += "DoubleBuffered";
     if (!(scene_flags & RTC_SCENE_FLAG_COMPACT) && !(scene_flags & RTC_SCENE_FLAG_ROBUST)) ret += "Fast"; 
     return ret;
   }
@@ -709,11 +719,14 @@ namespace embree
     for (unsigned int j = 0; j < N; j++) rays[j] = getRay(rayhit, N, j);
   }
 	
-  __noinline void IntersectWithModeInternal(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRayHit* rays, unsigned int N)
+  __noinline void IntersectWithModeInternal(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRayHit* rays, unsigned int N, RTCHitCollection* hitCollections = nullptr, const unsigned int* geometryVisibility = nullptr, RTCIntersectContextFlags contextFlags = RTC_INTERSECT_CONTEXT_FLAG_NONE)
   {
     RTCIntersectContext context;
     rtcInitIntersectContext(&context);
+    context.hitCollections = hitCollections;
+    context.geometryVisibility = geometryVisibility;
     context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT :  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+    context.flags = (RTCIntersectContextFlags) (context.flags | contextFlags);
 
     switch (mode) 
     {
@@ -834,7 +847,7 @@ namespace embree
     }
   }
 
-  void IntersectWithMode(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRayHit* rays, unsigned int N)
+  void IntersectWithMode(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRayHit* rays, unsigned int N, RTCHitCollection* hitCollections = nullptr, const unsigned int* geometryVisibility = nullptr, RTCIntersectContextFlags contextFlags = RTC_INTERSECT_CONTEXT_FLAG_NONE)
   {
     /* verify occluded result against intersect */
     if ((ivariant & VARIANT_INTERSECT_OCCLUDED) == VARIANT_INTERSECT_OCCLUDED)
@@ -845,8 +858,8 @@ namespace embree
         valid[i] = rays[i].ray.tnear <= rays[i].ray.tfar;
         rays2[i] = rays[i];
       }
-      IntersectWithModeInternal(mode,IntersectVariant(ivariant & ~VARIANT_OCCLUDED),scene,rays,N);
-      IntersectWithModeInternal(mode,IntersectVariant(ivariant & ~VARIANT_INTERSECT),scene,rays2.data(),N);
+      IntersectWithModeInternal(mode,IntersectVariant(ivariant & ~VARIANT_OCCLUDED),scene,rays,N,nullptr,geometryVisibility,contextFlags);
+      IntersectWithModeInternal(mode,IntersectVariant(ivariant & ~VARIANT_INTERSECT),scene,rays2.data(),N,nullptr,geometryVisibility,contextFlags);
       for (size_t i=0; i<N; i++)
       {
         if (valid[i] && ((rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID) != (rays2[i].ray.tfar != float(neg_inf)))) {
@@ -855,7 +868,7 @@ namespace embree
       }
     }
     else
-      IntersectWithModeInternal(mode,ivariant,scene,rays,N);
+      IntersectWithModeInternal(mode,ivariant,scene,rays,N,hitCollections,geometryVisibility,contextFlags);
   }
 
   enum GeometryType
@@ -22,6 +22,8 @@
 #include "../../common/algorithms/parallel_for.h"
 #include <regex>
 #include <stack>
+#include <set>
+#include <thread>
 
 #define random  use_random_function_of_test // do use random_int() and random_float() from Test class
 #define drand48 use_random_function_of_test // do use random_int() and random_float() from Test class
@@ -1090,6 +1092,896 @@ namespace embree
     }
   };
 
+  bool cancelCommitProgressFunction(void* ptr, double dn)
+  {
+    rtcCancelCommitScene((RTCScene) ptr);
+    return true;
+  }
+
+  struct BuildThreadsState
+  {
+    MutexSys mutex;
+    std::set<std::thread::id> threads;
+  };
+
+  bool recordBuildThreadsProgressFunction(void* ptr, double dn)
+  {
+    BuildThreadsState* state = (BuildThreadsState*) ptr;
+    Lock<MutexSys> lock(state->mutex);
+    state->threads.insert(std::this_thread::get_id());
+    return true;
+  }
+
+  struct CancelCommitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildPriority priority;
+
+    CancelCommitTest (std::string name, int isa, SceneFlags sflags, RTCBuildPriority priority)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), priority(priority) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      rtcSetSceneBuildPriority(scene,priority);
+      rtcSetSceneBuildThreadCount(scene,2);
+      AssertNoError(device);
+
+      const Vec3fa center = zero;
+      const float radius = 1.0f;
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(center,radius,50));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(center,radius,50));
+
+      /* the progress monitor cancels the commit */
+      rtcSetSceneProgressMonitorFunction(scene,cancelCommitProgressFunction,(RTCScene)scene);
+      rtcCommitScene (scene);
+      AssertError(device,RTC_ERROR_CANCELLED);
+
+      /* the cancellation does not affect the next commit, which uses at most the configured number of threads */
+      BuildThreadsState buildThreads;
+      rtcSetSceneProgressMonitorFunction(scene,recordBuildThreadsProgressFunction,&buildThreads);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      if (buildThreads.threads.size() == 0)
+        return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASKING_SYSTEM) == 0 && buildThreads.threads.size() > 2)
+        return VerifyApplication::FAILED;
+
+      /* a cancel issued before the build of an asynchronous commit started applies to that commit */
+      rtcSetSceneProgressMonitorFunction(scene,nullptr,nullptr);
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(center,radius,50));
+      RTCCommit commit = rtcCommitSceneAsync(scene,nullptr,nullptr);
+      rtcCancelCommitScene(scene);
+      const RTCError error = rtcWaitCommit(commit);
+      rtcReleaseCommit(commit);
+      if (error != RTC_ERROR_CANCELLED)
+        return VerifyApplication::FAILED;
+
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct AsyncCommitState
+  {
+    AsyncCommitState () : invocations(0), error(RTC_ERROR_UNKNOWN) {}
+    std::atomic<size_t> invocations;
+    RTCError error;
+  };
+
+  void asyncCommitCompletionFunction(void* ptr, RTCScene scene, RTCError error)
+  {
+    AsyncCommitState* state = (AsyncCommitState*) ptr;
+    state->error = error;
+    state->invocations++;
+  }
+
+  struct AsyncCommitReleaseState
+  {
+    AsyncCommitReleaseState () : commit(nullptr), finished(false), error(RTC_ERROR_UNKNOWN), done(false) {}
+    std::atomic<RTCCommit> commit;
+    std::atomic<bool> finished;
+    RTCError error;
+    bool done;
+  };
+
+  void asyncCommitReleaseFunction(void* ptr, RTCScene scene, RTCError error)
+  {
+    AsyncCommitReleaseState* state = (AsyncCommitReleaseState*) ptr;
+    RTCCommit commit = nullptr;
+    while ((commit = state->commit.load()) == nullptr) yield();
+
+    /* waiting on and releasing the commit from its own completion function must not join the commit thread */
+    state->error = rtcWaitCommit(commit);
+    state->done = rtcIsCommitDone(commit);
+    rtcReleaseCommit(commit);
+    state->finished = true;
+  }
+
+  struct AsyncCommitReleaseTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    AsyncCommitReleaseTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,50));
+
+      AsyncCommitReleaseState commitState;
+      commitState.commit = rtcCommitSceneAsync(scene,asyncCommitReleaseFunction,&commitState);
+      AssertNoError(device);
+      while (!commitState.finished) yield();
+      AssertNoError(device);
+
+      if (commitState.error != RTC_ERROR_NONE || !commitState.done)
+        return VerifyApplication::FAILED;
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct AsyncCommitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool cancel;
+
+    AsyncCommitTest (std::string name, int isa, SceneFlags sflags, bool cancel)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), cancel(cancel) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+
+      const Vec3fa center = zero;
+      const float radius = 1.0f;
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(center,radius,50));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(center,radius,50));
+      if (cancel) rtcSetSceneProgressMonitorFunction(scene,cancelCommitProgressFunction,(RTCScene)scene);
+
+      AsyncCommitState commitState;
+      RTCCommit commit = rtcCommitSceneAsync(scene,asyncCommitCompletionFunction,&commitState);
+      AssertNoError(device);
+      const RTCError expected = cancel ? RTC_ERROR_CANCELLED : RTC_ERROR_NONE;
+      const RTCError error = rtcWaitCommit(commit);
+      const bool done = rtcIsCommitDone(commit);
+      rtcReleaseCommit(commit);
+      AssertNoError(device);
+      
+      if (error != expected || !done || commitState.invocations != 1 || commitState.error != expected)
+        return VerifyApplication::FAILED;
+
+      /* bounds are only available for committed scenes */
+      RTCBounds bounds;
+      rtcGetSceneBounds(scene,&bounds);
+      if (cancel) AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      else        AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct DoubleBufferedSceneTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    DoubleBufferedSceneTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      scene.addSphere(sampler,sflags.qflags,Vec3fa(0,0,0),1.0f,50);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=1; i<=4; i++)
+      {
+        /* the previous version of the scene stays traceable during the commit */
+        scene.addSphere(sampler,sflags.qflags,Vec3fa(4.0f*i,0,0),1.0f,50);
+        RTCCommit commit = rtcCommitSceneAsync(scene,nullptr,nullptr);
+        bool passed = true;
+        do {
+          RTCRayHit ray = makeRay(Vec3fa(0,0,-10.0f),Vec3fa(0,0,1));
+          rtcIntersect1(scene,&context,&ray);
+          passed &= ray.hit.geomID == 0;
+        } while (!rtcIsCommitDone(commit));
+        
+        passed &= rtcWaitCommit(commit) == RTC_ERROR_NONE;
+        rtcReleaseCommit(commit);
+        if (!passed) return VerifyApplication::FAILED;
+
+        /* the new sphere is visible once the commit finished */
+        RTCRayHit ray = makeRay(Vec3fa(4.0f*i,0,-10.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&context,&ray);
+        if (ray.hit.geomID != i) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct BuilderConfigTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    std::string config;
+
+    BuilderConfigTest (std::string name, int isa, SceneFlags sflags, std::string config)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), config(config) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+","+config;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      scene.addSphere(sampler,sflags.qflags,Vec3fa(0,0,0),1.0f,50);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<256; i++)
+      {
+        const float x = 2.4f*random_float()-1.2f;
+        const float y = 2.4f*random_float()-1.2f;
+        const float r = sqrt(x*x+y*y);
+        if (r > 0.9f && r < 1.1f) continue;
+
+        RTCRayHit ray = makeRay(Vec3fa(x,y,-10.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&context,&ray);
+        if (r <= 0.9f && ray.hit.geomID != 0) return VerifyApplication::FAILED;
+        if (r >= 1.1f && ray.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SceneTimeRangeTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    size_t numTimeSteps;
+
+    SceneTimeRangeTest (std::string name, int isa, SceneFlags sflags, size_t numTimeSteps)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), numTimeSteps(numTimeSteps) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+
+      /* spheres move linearly from x=0 to x=10 */
+      avector<Vec3fa> motion_vector;
+      for (size_t i=0; i<numTimeSteps; i++)
+        motion_vector.push_back(Vec3fa(10.0f*float(i)/float(numTimeSteps-1),0.0f,0.0f));
+      
+      const unsigned geomID0 = scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(0,0,0),1.0f,50)->set_motion_vector(motion_vector));
+      const unsigned geomID1 = scene.addGeometry(sflags.qflags,SceneGraph::createQuadSphere(Vec3fa(0,3,0),1.0f,50)->set_motion_vector(motion_vector));
+
+      rtcSetSceneTimeRange(scene,0.25f,0.5f);
+      AssertNoError(device);
+      rtcSetSceneTimeRange(scene,0.5f,0.25f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<64; i++)
+      {
+        /* inside the time range rays hit the moving spheres, off their vertices and edges */
+        const float time0 = 0.25f+0.25f*random_float();
+        RTCRayHit ray0 = makeRay(Vec3fa(10.0f*time0+0.3f,0.2f,-10),Vec3fa(0,0,1)); ray0.ray.time = time0;
+        RTCRayHit ray1 = makeRay(Vec3fa(10.0f*time0+0.3f,3.2f,-10),Vec3fa(0,0,1)); ray1.ray.time = time0;
+        RTCRayHit ray2 = makeRay(Vec3fa(10.0f*time0+2,0,-10),Vec3fa(0,0,1)); ray2.ray.time = time0;
+        rtcIntersect1(scene,&context,&ray0);
+        rtcIntersect1(scene,&context,&ray1);
+        rtcIntersect1(scene,&context,&ray2);
+        if (ray0.hit.geomID != geomID0) return VerifyApplication::FAILED;
+        if (ray1.hit.geomID != geomID1) return VerifyApplication::FAILED;
+        if (ray2.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+
+        /* outside the time range no geometry got build */
+        const float time1 = 0.6f+0.4f*random_float();
+        RTCRayHit ray3 = makeRay(Vec3fa(10.0f*time1,0,-10),Vec3fa(0,0,1)); ray3.ray.time = time1;
+        rtcIntersect1(scene,&context,&ray3);
+        if (ray3.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct GeometryTimeStepsTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    size_t numTimeSteps;
+    bool nonuniform;
+
+    GeometryTimeStepsTest (std::string name, int isa, SceneFlags sflags, size_t numTimeSteps, bool nonuniform)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), numTimeSteps(numTimeSteps), nonuniform(nonuniform) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+
+      /* time steps cover [0.25,0.75], non-uniform steps are denser at the start */
+      std::vector<float> times(numTimeSteps);
+      for (size_t i=0; i<numTimeSteps; i++) {
+        const float f = float(i)/float(numTimeSteps-1);
+        times[i] = 0.25f + 0.5f*(nonuniform ? f*f : f);
+      }
+
+      /* spheres are at x=10*time during the time range */
+      avector<Vec3fa> motion_vector;
+      for (size_t i=0; i<numTimeSteps; i++)
+        motion_vector.push_back(Vec3fa(10.0f*times[i],0.0f,0.0f));
+      
+      const unsigned geomID0 = scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(0,0,0),1.0f,50)->set_motion_vector(motion_vector));
+      const unsigned geomID1 = scene.addGeometry(sflags.qflags,SceneGraph::createQuadSphere(Vec3fa(0,3,0),1.0f,50)->set_motion_vector(motion_vector));
+      for (unsigned geomID : { geomID0, geomID1 })
+      {
+        RTCGeometry geom = rtcGetGeometry(scene,geomID);
+        rtcSetGeometryTimeRange(geom,0.5f,0.25f);
+        AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+        if (nonuniform) rtcSetGeometryTimeSteps(geom,times.data());
+        else            rtcSetGeometryTimeRange(geom,0.25f,0.75f);
+        AssertNoError(device);
+        rtcCommitGeometry(geom);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<64; i++)
+      {
+        /* spheres stay at their first and last position outside the time range,
+         * rays pass them off their vertices and edges */
+        const float time = random_float();
+        const float x = 10.0f*clamp(time,0.25f,0.75f);
+        RTCRayHit ray0 = makeRay(Vec3fa(x+0.3f,0.2f,-10),Vec3fa(0,0,1)); ray0.ray.time = time;
+        RTCRayHit ray1 = makeRay(Vec3fa(x+0.3f,3.2f,-10),Vec3fa(0,0,1)); ray1.ray.time = time;
+        RTCRayHit ray2 = makeRay(Vec3fa(x+2,0,-10),Vec3fa(0,0,1)); ray2.ray.time = time;
+        rtcIntersect1(scene,&context,&ray0);
+        rtcIntersect1(scene,&context,&ray1);
+        rtcIntersect1(scene,&context,&ray2);
+        if (ray0.hit.geomID != geomID0) return VerifyApplication::FAILED;
+        if (ray1.hit.geomID != geomID1) return VerifyApplication::FAILED;
+        if (ray2.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct PointQueryTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    PointQueryTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+
+      /* the third sphere moves from x=8 to x=10 */
+      const Vec3fa centers[3] = { Vec3fa(0,0,0), Vec3fa(0,4,0), Vec3fa(8,0,0) };
+      unsigned geomIDs[3];
+      geomIDs[0] = scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(centers[0],1.0f,50));
+      geomIDs[1] = scene.addGeometry(sflags.qflags,SceneGraph::createQuadSphere(centers[1],1.0f,50));
+      geomIDs[2] = scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(centers[2],1.0f,50)->set_motion_vector(Vec3fa(2.0f,0.0f,0.0f)));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      const float eps = 0.01f;
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa p(15.0f*random_float()-3.0f,10.0f*random_float()-3.0f,6.0f*random_float()-3.0f);
+        const float time = random_float();
+
+        /* distance to the closest sphere surface */
+        float dist = inf; unsigned geomID = RTC_INVALID_GEOMETRY_ID; float dist2 = inf;
+        for (size_t j=0; j<3; j++) {
+          const Vec3fa c = centers[j] + (j == 2 ? Vec3fa(2.0f*time,0.0f,0.0f) : Vec3fa(zero));
+          const float d = abs(length(p-c)-1.0f);
+          if (d < dist) { dist2 = dist; dist = d; geomID = geomIDs[j]; }
+          else dist2 = min(dist2,d);
+        }
+
+        RTCPointQuery query; query.x = p.x; query.y = p.y; query.z = p.z; query.time = time; query.radius = inf;
+        RTCPointQueryResult result;
+        if (!rtcPointQuery(scene,&query,&result,nullptr,nullptr)) return VerifyApplication::FAILED;
+        if (abs(query.radius-dist) > eps) return VerifyApplication::FAILED;
+        if (abs(length(Vec3fa(result.x,result.y,result.z)-p)-query.radius) > eps) return VerifyApplication::FAILED;
+        if (dist2-dist > 2.0f*eps && result.geomID != geomID) return VerifyApplication::FAILED;
+
+        /* nothing is found when the radius is smaller than the distance */
+        if (dist > 2.0f*eps) {
+          query.radius = dist-2.0f*eps;
+          if (rtcPointQuery(scene,&query,&result,nullptr,nullptr)) return VerifyApplication::FAILED;
+          if (result.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CoherentShadowStreamTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    CoherentShadowStreamTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,MODE_INTERSECT1M))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,50));
+      scene.addGeometry(sflags.qflags,SceneGraph::createQuadSphere(Vec3fa(+1,0,0),1.0f,50));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      RTCIntersectContext coherentContext;
+      rtcInitIntersectContext(&coherentContext);
+      coherentContext.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
+
+      for (size_t N : { 4, 16, 64, 256 })
+      {
+        /* shadow rays from a small tile towards an area light in front of and one behind the tile,
+           thus the directions of the stream span all eight octants */
+        std::vector<RTCRayHit> rays(N), rays0(N), rays1(N);
+        std::vector<RTCRay*> rptrs(N);
+        for (size_t i=0; i<N; i++)
+        {
+          const Vec3fa org(0.5f+0.01f*random_float(),0.01f*random_float(),-4.0f);
+          const float lightZ = (i%4 == 0) ? -8.0f : 4.0f;
+          const Vec3fa light(8.0f*random_float()-4.0f,8.0f*random_float()-4.0f,lightZ);
+          rays[i] = makeRay(org,light-org,0.0f,1.0f);
+          rays0[i] = rays1[i] = rays[i];
+          rptrs[i] = &rays1[i].ray;
+          rtcOccluded1(scene,&context,&rays[i].ray);
+        }
+        rtcOccluded1M(scene,&coherentContext,&rays0[0].ray,(unsigned int)N,sizeof(RTCRayHit));
+        rtcOccluded1Mp(scene,&coherentContext,rptrs.data(),(unsigned int)N);
+        AssertNoError(device);
+
+        for (size_t i=0; i<N; i++)
+        {
+          const bool occluded = rays[i].ray.tfar < 0.0f;
+          if ((rays0[i].ray.tfar < 0.0f) != occluded) return VerifyApplication::FAILED;
+          if ((rays1[i].ray.tfar < 0.0f) != occluded) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct ReducedHitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCIntersectContextFlags iflags;
+
+    ReducedHitTest (std::string name, int isa, SceneFlags sflags, RTCIntersectContextFlags iflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), iflags(iflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,MODE_INTERSECT1M))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,50));
+      scene.addGeometry(sflags.qflags,SceneGraph::createQuadSphere(Vec3fa(+1,0,0),1.0f,50));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      RTCIntersectContext reducedContext;
+      rtcInitIntersectContext(&reducedContext);
+      reducedContext.flags = RTCIntersectContextFlags(iflags | RTC_INTERSECT_CONTEXT_FLAG_REDUCED_HIT);
+
+      const size_t N = 64;
+      RTCRayHit rays[N], rays0[N], rays1[N];
+      RTCRayHit* rptrs[N];
+      for (size_t i=0; i<N; i++) {
+        /* every fourth ray misses, all other rays hit well inside the silhouette of a sphere */
+        const float x = (i%2 ? -1.0f : 1.0f) + random_float()-0.5f;
+        const float y = (i%4 == 0) ? 4.0f : random_float()-0.5f;
+        rays[i] = makeRay(Vec3fa(x,y,-4.0f),Vec3fa(0,0,1));
+        rays[i].hit.Ng_x = rays[i].hit.Ng_y = rays[i].hit.Ng_z = rays[i].hit.u = rays[i].hit.v = 123.0f;
+        rays0[i] = rays1[i] = rays[i];
+        rptrs[i] = &rays1[i];
+        rtcIntersect1(scene,&context,&rays[i]);
+      }
+      rtcIntersect1M(scene,&reducedContext,rays0,N,sizeof(RTCRayHit));
+      rtcIntersect1Mp(scene,&reducedContext,rptrs,N);
+      AssertNoError(device);
+
+      /* only distance and IDs of the hits get written */
+      for (const RTCRayHit* result : { rays0, rays1 })
+      {
+        for (size_t i=0; i<N; i++)
+        {
+          if (result[i].hit.geomID != rays[i].hit.geomID) return VerifyApplication::FAILED;
+          if (result[i].hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+          if (result[i].hit.primID != rays[i].hit.primID) return VerifyApplication::FAILED;
+          if (abs(result[i].ray.tfar-rays[i].ray.tfar) > 1E-4f) return VerifyApplication::FAILED;
+          if (result[i].hit.Ng_x != 123.0f || result[i].hit.u != 123.0f || result[i].hit.v != 123.0f) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TraversalStatisticsTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    TraversalStatisticsTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static void countingFilter(const RTCFilterFunctionNArguments* args) {
+      (*(size_t*)args->geometryUserPtr)++;
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* stack of planes at z=1,2,3,4 whose filter functions count their calls */
+      size_t filterCalls = 0;
+      VerifyScene scene(device,sflags);
+      for (unsigned int i=0; i<4; i++) {
+        scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(Vec3fa(-10.0f,-10.0f,float(i+1)),Vec3fa(20,0,0),Vec3fa(0,20,0),8,8));
+        RTCGeometry geom = rtcGetGeometry(scene,i);
+        rtcSetGeometryUserData(geom,&filterCalls);
+        rtcSetGeometryIntersectFilterFunction(geom,countingFilter);
+        rtcSetGeometryOccludedFilterFunction(geom,countingFilter);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCTraversalStatistics stats;
+      rtcInitTraversalStatistics(&stats,RTC_TRAVERSAL_STATISTICS_FLAG_PERF_COUNTERS);
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      context.statistics = &stats;
+
+      const size_t N = 64;
+      for (size_t i=0; i<N; i++) {
+        RTCRayHit ray = makeRay(Vec3fa(18.0f*random_float()-9.0f,18.0f*random_float()-9.0f,0.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&context,&ray);
+        if (ray.hit.geomID != 0) return VerifyApplication::FAILED;
+      }
+      if (stats.intersect.filterCalls != filterCalls) return VerifyApplication::FAILED;
+
+      filterCalls = 0;
+      for (size_t i=0; i<N; i++) {
+        RTCRayHit ray = makeRay(Vec3fa(18.0f*random_float()-9.0f,18.0f*random_float()-9.0f,0.0f),Vec3fa(0,0,1));
+        rtcOccluded1(scene,&context,&ray.ray);
+        if (ray.ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;
+      }
+      if (stats.occluded.filterCalls != filterCalls) return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      /* every ray visits at least one node and leaf, and tests at least one primitive */
+      for (const RTCTraversalCounters* counters : { &stats.intersect, &stats.occluded })
+      {
+        if (counters->calls != N || counters->rays != N) return VerifyApplication::FAILED;
+        if (counters->nodeVisits < N || counters->leafVisits < N) return VerifyApplication::FAILED;
+        if (counters->primitiveTests < counters->leafVisits) return VerifyApplication::FAILED;
+        if (counters->filterCalls == 0 && rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED)) return VerifyApplication::FAILED;
+      }
+
+      /* packets count their active rays, and contexts without statistics count nothing */
+      if (supportsIntersectMode(device,MODE_INTERSECT4))
+      {
+        __aligned(16) int valid[4] = { -1, 0, -1, 0 };
+        RTCRayHit4 ray4;
+        for (size_t i=0; i<4; i++) setRay(ray4,i,makeRay(Vec3fa(0.1f,0.2f,0.0f),Vec3fa(0,0,1)));
+        rtcIntersect4(valid,scene,&context,&ray4);
+        context.statistics = nullptr;
+        rtcIntersect4(valid,scene,&context,&ray4);
+        AssertNoError(device);
+        if (stats.intersect.calls != N+1 || stats.intersect.rays != N+2) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct LodConeTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    LodConeTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      const BBox3fa box(Vec3fa(-1,-1,9),Vec3fa(1,1,11));
+      unsigned geomID = scene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(center(box),1.0f,100));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      /* the ray footprint is much larger than the sphere */
+      RTCIntersectContext lodContext;
+      rtcInitIntersectContext(&lodContext);
+      lodContext.lodConeAngle = 1.0f;
+
+      const float eps = 0.001f;
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa dir = normalize(Vec3fa(3.0f*random_float()-1.5f,3.0f*random_float()-1.5f,10.0f));
+        RTCRayHit ray0 = makeRay(zero,dir);
+        RTCRayHit ray1 = makeRay(zero,dir);
+        RTCRay ray2 = makeRay(zero,dir).ray;
+        rtcIntersect1(scene,&context,&ray0);
+        rtcIntersect1(scene,&lodContext,&ray1);
+        rtcOccluded1(scene,&lodContext,&ray2);
+
+        /* proxy hits lie inside the bounds of the sphere, but not behind the exact hit */
+        const Vec3fa t0 = (box.lower-Vec3fa(zero))*rcp_safe(dir);
+        const Vec3fa t1 = (box.upper-Vec3fa(zero))*rcp_safe(dir);
+        const float tnear = reduce_max(min(t0,t1));
+        const float tfar  = reduce_min(max(t0,t1));
+        if (ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID && ray1.hit.geomID != geomID) return VerifyApplication::FAILED;
+        if ((ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID) != (ray2.tfar == float(neg_inf))) return VerifyApplication::FAILED;
+        if (ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (ray1.hit.geomID != geomID) return VerifyApplication::FAILED;
+        if (ray1.ray.tfar < tnear-eps || ray1.ray.tfar > tfar+eps) return VerifyApplication::FAILED;
+        if (ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID && ray1.ray.tfar > ray0.ray.tfar+eps) return VerifyApplication::FAILED;
+      }
+
+      /* proxy hits get collected in hit collection mode */
+      RTCCollectedHit hits[4];
+      RTCHitCollection collection;
+      collection.hits = hits;
+      collection.maxHitCount = 4;
+      collection.hitCount = 0;
+      RTCIntersectContext collectContext = lodContext;
+      collectContext.hitCollections = &collection;
+      RTCRayHit ray3 = makeRay(zero,Vec3fa(0,0,1));
+      rtcIntersect1(scene,&collectContext,&ray3);
+      if (ray3.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      if (collection.hitCount == 0 || hits[0].geomID != geomID) return VerifyApplication::FAILED;
+
+      /* proxies of culled geometries neither hit nor occlude */
+      const unsigned int visibility = 0;
+      RTCIntersectContext cullContext = lodContext;
+      cullContext.geometryVisibility = &visibility;
+      RTCRayHit ray4 = makeRay(zero,Vec3fa(0,0,1));
+      RTCRay ray5 = makeRay(zero,Vec3fa(0,0,1)).ray;
+      rtcIntersect1(scene,&cullContext,&ray4);
+      rtcOccluded1(scene,&cullContext,&ray5);
+      if (ray4.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      if (ray5.tfar == float(neg_inf)) return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct QuaternionInstanceTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    size_t numTimeSteps;
+
+    QuaternionInstanceTest (std::string name, int isa, SceneFlags sflags, size_t numTimeSteps)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), numTimeSteps(numTimeSteps) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene object(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      object.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(3,0,0),1.0f,50));
+      rtcCommitScene (object);
+      AssertNoError(device);
+
+      /* instance rotates the sphere by 270 degrees around the z axis, with two time
+       * steps the negative dot product of the quaternions selects the longer arc */
+      const float maxAngle = 1.5f*float(pi);
+      VerifyScene scene(device,sflags);
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(geom,object);
+      rtcSetGeometryTimeStepCount(geom,(unsigned int)numTimeSteps);
+      for (size_t i=0; i<numTimeSteps; i++)
+      {
+        const float angle = maxAngle*float(i)/float(numTimeSteps-1);
+        const RTCQuaternionDecomposition qd = { 1.0f, 1.0f, 1.0f, cosf(0.5f*angle), 0.0f, 0.0f, sinf(0.5f*angle), 0.0f, 0.0f, 0.0f };
+        rtcSetGeometryTransform(geom,(unsigned int)i,RTC_FORMAT_QUATERNION_DECOMPOSITION,&qd);
+      }
+      AssertNoError(device);
+      const RTCQuaternionDecomposition invalid = { 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+      rtcSetGeometryTransform(geom,0,RTC_FORMAT_QUATERNION_DECOMPOSITION,&invalid);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcCommitGeometry(geom);
+
+      /* opposite quaternions describe a full turn around an undefined axis */
+      {
+        RTCGeometry turn = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(turn,object);
+        rtcSetGeometryTimeStepCount(turn,2);
+        const RTCQuaternionDecomposition qd0 = { 1.0f, 1.0f, 1.0f,  1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        const RTCQuaternionDecomposition qd1 = { 1.0f, 1.0f, 1.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        rtcSetGeometryTransform(turn,0,RTC_FORMAT_QUATERNION_DECOMPOSITION,&qd0);
+        rtcSetGeometryTransform(turn,1,RTC_FORMAT_QUATERNION_DECOMPOSITION,&qd1);
+        rtcCommitGeometry(turn);
+        AssertError(device,RTC_ERROR_INVALID_OPERATION);
+        rtcReleaseGeometry(turn);
+      }
+      const unsigned int instID = rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<16; i++)
+      {
+        /* rays through the rotated sphere hit, rays 1.5 times further outwards miss,
+         * the hit point (3.3,0.2) keeps rays off the vertices and edges of the sphere */
+        RTCRayHit4 ray4; 
+        for (size_t j=0; j<4; j++)
+        {
+          const float time = random_float();
+          const float c0 = cosf(maxAngle*time), s0 = sinf(maxAngle*time);
+          const Vec3fa c(3.3f*c0-0.2f*s0,3.3f*s0+0.2f*c0,0.0f);
+          RTCRayHit ray0 = makeRay(c+Vec3fa(0,0,-10),Vec3fa(0,0,1)); ray0.ray.time = time;
+          RTCRayHit ray1 = makeRay(1.5f*c+Vec3fa(0,0,-10),Vec3fa(0,0,1)); ray1.ray.time = time;
+          rtcIntersect1(scene,&context,&ray0);
+          rtcIntersect1(scene,&context,&ray1);
+          if (ray0.hit.instID[0] != instID) return VerifyApplication::FAILED;
+          if (ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          setRay(ray4,j,makeRay(c+Vec3fa(0,0,-10),Vec3fa(0,0,1)));
+          ray4.ray.time[j] = time;
+        }
+
+        /* ray packets with different times per ray */
+        __aligned(16) int valid4[4] = { -1,-1,-1,-1 };
+        rtcIntersect4(valid4,scene,&context,&ray4);
+        for (size_t j=0; j<4; j++)
+          if (ray4.hit.instID[0][j] != instID) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct DoubleOriginInstanceTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    DoubleOriginInstanceTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene object(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      object.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTrianglePlane(Vec3fa(0,0,0),Vec3fa(1,0,0),Vec3fa(0,1,0),1,1));
+      rtcCommitScene (object);
+      AssertNoError(device);
+
+      /* the instance is placed far away from the world origin, where float spacing is 0.0625 */
+      const double origin[3] = { 3000000.0, -2000000.0, 1000000.0 };
+      VerifyScene scene(device,sflags);
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(geom,object);
+      rtcSetGeometryTransformOrigin(geom,origin[0],origin[1],origin[2]);
+      rtcCommitGeometry(geom);
+      const unsigned int instID = rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* rays start 0.3 units in front of the plane, which is not representable in float */
+      const float dist = 0.3f, eps = 0.001f;
+      double rayOrigins[4*3];
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      context.rayOrigins = rayOrigins;
+
+      for (size_t i=0; i<16; i++)
+      {
+        RTCRayHit4 ray4; 
+        for (unsigned int j=0; j<4; j++)
+        {
+          double* dorg = &rayOrigins[3*j];
+          dorg[0] = origin[0]+0.1+0.8*random_float();
+          dorg[1] = origin[1]+0.1+0.8*random_float();
+          dorg[2] = origin[2]-dist;
+          RTCRayHit ray0 = makeRay(Vec3fa(float(dorg[0]),float(dorg[1]),float(dorg[2])),Vec3fa(0,0,1)); ray0.ray.id = j;
+          RTCRay ray1 = makeRay(Vec3fa(float(dorg[0]),float(dorg[1]),float(dorg[2])),Vec3fa(0,0,1),0.0f,dist-eps).ray; ray1.id = j;
+          RTCRay ray2 = makeRay(Vec3fa(float(dorg[0]),float(dorg[1]),float(dorg[2])),Vec3fa(0,0,1),0.0f,dist+eps).ray; ray2.id = j;
+          rtcIntersect1(scene,&context,&ray0);
+          rtcOccluded1(scene,&context,&ray1);
+          rtcOccluded1(scene,&context,&ray2);
+          if (ray0.hit.instID[0] != instID) return VerifyApplication::FAILED;
+          if (abs(ray0.ray.tfar-dist) > 0.1f*eps) return VerifyApplication::FAILED;
+          if (ray1.tfar == float(neg_inf)) return VerifyApplication::FAILED;
+          if (ray2.tfar != float(neg_inf)) return VerifyApplication::FAILED;
+          ray0 = makeRay(Vec3fa(float(dorg[0]),float(dorg[1]),float(dorg[2])),Vec3fa(0,0,1)); ray0.ray.id = j;
+          setRay(ray4,j,ray0);
+        }
+
+        __aligned(16) int valid4[4] = { -1,-1,-1,-1 };
+        rtcIntersect4(valid4,scene,&context,&ray4);
+        for (size_t j=0; j<4; j++) {
+          if (ray4.hit.instID[0][j] != instID) return VerifyApplication::FAILED;
+          if (abs(ray4.ray.tfar[j]-dist) > 0.1f*eps) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -1334,58 +2226,463 @@ namespace embree
       case LINE_GEOMETRY_MB: mesh = mesh->set_motion_vector(random_motion_vector2(0.0001f)); break;
       default: break;
       }
-      NN = mesh->numPrimitives(); 
-      scene.addGeometry(quality,mesh);
-      rtcCommitScene (scene);
+      NN = mesh->numPrimitives(); 
+      scene.addGeometry(quality,mesh);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      
+      return std::make_pair(NN,memory_consumption_bytes_used.load());
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      VerifyApplication::TestReturnValue ret = VerifyApplication::PASSED;
+
+      size_t maxN = 0;
+      switch (gtype) {
+      case LINE_GEOMETRY:    
+      case LINE_GEOMETRY_MB: 
+      case HAIR_GEOMETRY:
+      case HAIR_GEOMETRY_MB: maxN = 250000; break;
+      default: maxN = 1000000; break;
+      }
+      
+      for (size_t N=128; N<maxN; N = (size_t)((float)N * 1.5f)) 
+      {
+        auto bytes_one_thread  = run_build(state,N,1);
+        auto bytes_all_threads = run_build(state,N,0);
+        double bytes_expected = expected_size(state,bytes_one_thread.first);
+        double expected_to_single = double(bytes_one_thread.second)/double(bytes_expected);
+        double single_to_threaded = double(bytes_all_threads.second)/double(bytes_one_thread.second);
+     
+        const bool failed0 = expected_to_single > 1.0f;
+        const bool failed1 = (sflags.qflags == RTC_BUILD_QUALITY_LOW) ? single_to_threaded > 1.35f : single_to_threaded > 1.12f;
+
+        if (failed0 || failed1) {
+          std::cout << state->red ("-") << std::flush;
+          ret = VerifyApplication::FAILED;
+        } else {
+          std::cout << state->green ("+") << std::flush;
+        }
+
+        if (failed0 || failed1)
+        {
+          double num_primitives = (double)bytes_one_thread.first;
+          std::cout << "N = " << num_primitives << ", n = " << ceilf(sqrtf(N/4.0f)) << ", "
+            "expected = " << bytes_expected/num_primitives << " B, " << 
+            "1 thread = " << bytes_one_thread.second/num_primitives << " B (" << 100.0f*expected_to_single << " %)" << (failed0 ? state->red(" [FAILED]") : "") << ", " << 
+            "all_threads = " << bytes_all_threads.second/num_primitives << " B (" << 100.0f*single_to_threaded << " %)" << (failed1 ? state->red(" [FAILED]") : "") << std::endl;
+        }
+      }
+      return ret;
+    }
+  };
+    
+  struct AllocatorTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    AllocatorTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    struct AllocatorState
+    {
+      AllocatorState () : numAllocations(0), bytesAllocated(0) {}
+      
+      std::atomic<ssize_t> numAllocations;
+      std::atomic<ssize_t> bytesAllocated;
+    };
+
+    static void* allocFunction(void* ptr, size_t bytes, size_t alignment, RTCAllocationFlags flags)
+    {
+      AllocatorState* allocator = (AllocatorState*) ptr;
+      allocator->numAllocations++;
+      allocator->bytesAllocated += bytes;
+      return alignedMalloc(bytes,max(alignment,size_t(64)));
+    }
+
+    static void freeFunction(void* ptr, void* mem, size_t bytes)
+    {
+      AllocatorState* allocator = (AllocatorState*) ptr;
+      allocator->numAllocations--;
+      allocator->bytesAllocated -= bytes;
+      alignedFree(mem);
+    }
+
+    static size_t shrinkFunction(void* ptr, void* mem, size_t bytesNew, size_t bytesOld)
+    {
+      /* the memory stays allocated, we only track the size reported back to the device */
+      AllocatorState* allocator = (AllocatorState*) ptr;
+      allocator->bytesAllocated -= bytesOld-bytesNew;
+      return bytesNew;
+    }
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      AllocatorState allocator;
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        rtcSetDeviceAllocator(device,allocFunction,freeFunction,shrinkFunction,&allocator);
+        AssertNoError(device);
+
+        {
+          VerifyScene scene(device,sflags);
+          scene.addSphere(sampler,sflags.qflags,Vec3fa(0,0,0),1.0f,200);
+          rtcCommitScene (scene);
+          AssertNoError(device);
+
+          /* the allocator cannot get changed while memory is allocated through it */
+          rtcSetDeviceAllocator(device,nullptr,nullptr,nullptr,nullptr);
+          AssertError(device,RTC_ERROR_INVALID_OPERATION);
+          if (allocator.numAllocations == 0) return VerifyApplication::FAILED;
+
+          RTCRayHit ray = makeRay(Vec3fa(0,0,-10.0f),Vec3fa(0,0,1));
+          rtcIntersect1(scene,&context,&ray);
+          if (ray.hit.geomID != 0) return VerifyApplication::FAILED;
+        }
+      }
+
+      /* all memory got returned to the allocator */
+      if (allocator.numAllocations != 0 || allocator.bytesAllocated != 0)
+        return VerifyApplication::FAILED;
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+    
+  struct BuildArenaTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    /*! memory monitor that tracks the reported bytes and denies allocations exceeding a limit */
+    struct Monitor
+    {
+      Monitor () : bytes(0), peakBytes(0), maxBytes(std::numeric_limits<ssize_t>::max()) {}
+
+      static bool monitor(void* ptr, ssize_t bytes, bool post)
+      {
+        Monitor* This = (Monitor*) ptr;
+        const ssize_t newBytes = This->bytes += bytes;
+        if (!post && bytes > 0 && newBytes > This->maxBytes) {
+          This->bytes -= bytes;
+          return false;
+        }
+        This->peakBytes = max(This->peakBytes.load(),newBytes);
+        return true;
+      }
+
+      std::atomic<ssize_t> bytes;
+      std::atomic<ssize_t> peakBytes;
+      std::atomic<ssize_t> maxBytes;
+    };
+
+    /* returns the peak memory usage of a build of a sphere without build arena */
+    ssize_t peakBuildBytes(VerifyApplication* state, size_t numPhi)
+    {
+      /* the monitor has to outlive the device */
+      Monitor monitor;
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      rtcSetDeviceMemoryMonitorFunction(device,Monitor::monitor,&monitor);
+      {
+        VerifyScene scene(device,sflags);
+        scene.addSphere(sampler,sflags.qflags,Vec3fa(0,0,0),1.0f,numPhi);
+        rtcCommitScene (scene);
+      }
+      return monitor.peakBytes;
+    }
+
+    BuildArenaTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      const ssize_t maxBytes = 64*1024*1024;
+      Monitor monitor;
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",build_arena_size=64";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_BUILD_ARENA_SIZE) != maxBytes)
+        return VerifyApplication::FAILED;
+      rtcSetDeviceMemoryMonitorFunction(device,Monitor::monitor,&monitor);
+
+      ssize_t cachedBytes = 0;
+      for (size_t i=0; i<4; i++)
+      {
+        {
+          VerifyScene scene(device,sflags);
+          scene.addSphere(sampler,sflags.qflags,Vec3fa(0,0,0),1.0f,200);
+          rtcCommitScene (scene);
+          AssertNoError(device);
+
+          RTCRayHit ray = makeRay(Vec3fa(0,0,-10.0f),Vec3fa(0,0,1));
+          rtcIntersect1(scene,&context,&ray);
+          if (ray.hit.geomID != 0) return VerifyApplication::FAILED;
+        }
+
+        /* the temporaries of the build got cached and get reused by the following builds */
+        const ssize_t bytes = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_BUILD_ARENA_CACHED_BYTES);
+        if (bytes <= 0 || bytes > maxBytes) return VerifyApplication::FAILED;
+        if (i == 0) cachedBytes = bytes;
+        else if (bytes != cachedBytes) return VerifyApplication::FAILED;
+
+        /* cached memory stays reported to the memory monitor */
+        if (monitor.bytes < cachedBytes) return VerifyApplication::FAILED;
+      }
+
+      /* a larger build only fits into the memory limit when the cached memory gets released */
+      const ssize_t peakBytes = peakBuildBytes(state,400);
+      monitor.maxBytes = monitor.bytes - cachedBytes + peakBytes + cachedBytes/2;
+      {
+        VerifyScene scene(device,sflags);
+        scene.addSphere(sampler,sflags.qflags,Vec3fa(0,0,0),1.0f,400);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        RTCRayHit ray = makeRay(Vec3fa(0,0,-10.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&context,&ray);
+        if (ray.hit.geomID != 0) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+    
+  /* checks if the system provides transparent huge pages to madvise'd memory */
+  static bool transparentHugePagesAvailable()
+  {
+#if defined(__LINUX__)
+    std::ifstream thp("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string mode;
+    if (!std::getline(thp,mode)) return false;
+    return mode.find("[never]") == std::string::npos;
+#else
+    return false;
+#endif
+  }
+
+  struct TransparentHugePagesTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    TransparentHugePagesTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      if (!transparentHugePagesAvailable())
+        return VerifyApplication::SKIPPED;
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",transparent_hugepages=1";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const ssize_t hugepageBytes = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_HUGEPAGE_ADVISED_BYTES);
+      if (hugepageBytes < 0) return VerifyApplication::FAILED;
+      
+      {
+        /* the BVH of the sphere is large enough to get allocated in blocks that cover full 2MB pages,
+           compact BVHs need a finer sphere for that */
+        VerifyScene scene(device,sflags);
+        scene.addSphere(sampler,sflags.qflags,Vec3fa(0,0,0),1.0f,(sflags.sflags & RTC_SCENE_FLAG_COMPACT) ? 1000 : 500);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+        if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_HUGEPAGE_ADVISED_BYTES) <= hugepageBytes)
+          return VerifyApplication::FAILED;
+
+        RTCRayHit ray = makeRay(Vec3fa(0,0,-10.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&context,&ray);
+        if (ray.hit.geomID != 0) return VerifyApplication::FAILED;
+      }
+
+      /* all huge page memory of the scene got released */
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_HUGEPAGE_ADVISED_BYTES) != hugepageBytes)
+        return VerifyApplication::FAILED;
+      
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+    
+  static void join_thread_pool_thread(RTCDevice device) {
+    rtcJoinDeviceThreadPool(device);
+  }
+
+  struct ThreadPoolJoinTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    ThreadPoolJoinTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      /* the application lends all threads but the committing thread, thus the thread pool starts no own threads */
+      const size_t numThreads = 4;
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",threads="+std::to_string(numThreads)+",user_threads="+std::to_string(numThreads-1);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      std::vector<thread_t> threads;
+      for (size_t i=0; i<numThreads-1; i++)
+        threads.push_back(createThread((thread_func)join_thread_pool_thread,(RTCDevice)device,DEFAULT_STACK_SIZE));
+      while (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT) != ssize_t(numThreads-1))
+        yield();
+
+      bool passed = true;
+      for (size_t i=0; i<4 && passed; i++)
+      {
+        VerifyScene scene(device,sflags);
+        scene.addSphere(sampler,sflags.qflags,Vec3fa(0,0,0),1.0f,200);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        RTCRayHit ray = makeRay(Vec3fa(0,0,-10.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&context,&ray);
+        passed &= ray.hit.geomID == 0;
+      }
+
+      /* all joined threads return */
+      rtcLeaveDeviceThreadPool(device);
+      for (size_t i=0; i<threads.size(); i++)
+        join(threads[i]);
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT) != 0)
+        return VerifyApplication::FAILED;
+
       AssertNoError(device);
-      
-      return std::make_pair(NN,memory_consumption_bytes_used.load());
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
     }
+  };
     
-    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
-    {
-      VerifyApplication::TestReturnValue ret = VerifyApplication::PASSED;
+  struct ThreadPoolLeaveTest : public VerifyApplication::Test
+  {
+    ThreadPoolLeaveTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
 
-      size_t maxN = 0;
-      switch (gtype) {
-      case LINE_GEOMETRY:    
-      case LINE_GEOMETRY_MB: 
-      case HAIR_GEOMETRY:
-      case HAIR_GEOMETRY_MB: maxN = 250000; break;
-      default: maxN = 1000000; break;
-      }
-      
-      for (size_t N=128; N<maxN; N = (size_t)((float)N * 1.5f)) 
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",user_threads=1";
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      /* leaving through one device keeps the threads joined through other devices */
+      thread_t thread0 = createThread((thread_func)join_thread_pool_thread,(RTCDevice)device0,DEFAULT_STACK_SIZE);
+      thread_t thread1 = createThread((thread_func)join_thread_pool_thread,(RTCDevice)device1,DEFAULT_STACK_SIZE);
+      while (rtcGetDeviceProperty(device0,RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT) != 1) yield();
+      while (rtcGetDeviceProperty(device1,RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT) != 1) yield();
+
+      rtcLeaveDeviceThreadPool(device0);
+      join(thread0);
+      if (rtcGetDeviceProperty(device0,RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT) != 0)
+        return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device1,RTC_DEVICE_PROPERTY_JOINED_THREAD_COUNT) != 1)
+        return VerifyApplication::FAILED;
+
+      rtcLeaveDeviceThreadPool(device1);
+      join(thread1);
+
+      /* threads that join after the leave return immediately */
+      rtcJoinDeviceThreadPool(device0);
+      for (size_t i=0; i<16; i++)
       {
-        auto bytes_one_thread  = run_build(state,N,1);
-        auto bytes_all_threads = run_build(state,N,0);
-        double bytes_expected = expected_size(state,bytes_one_thread.first);
-        double expected_to_single = double(bytes_one_thread.second)/double(bytes_expected);
-        double single_to_threaded = double(bytes_all_threads.second)/double(bytes_one_thread.second);
-     
-        const bool failed0 = expected_to_single > 1.0f;
-        const bool failed1 = (sflags.qflags == RTC_BUILD_QUALITY_LOW) ? single_to_threaded > 1.35f : single_to_threaded > 1.12f;
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        thread_t thread = createThread((thread_func)join_thread_pool_thread,(RTCDevice)device,DEFAULT_STACK_SIZE);
+        rtcLeaveDeviceThreadPool(device);
+        join(thread);
+        AssertNoError(device);
+      }
 
-        if (failed0 || failed1) {
-          std::cout << state->red ("-") << std::flush;
-          ret = VerifyApplication::FAILED;
-        } else {
-          std::cout << state->green ("+") << std::flush;
-        }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return VerifyApplication::PASSED;
+    }
+  };
+    
+#if defined(TASKING_INTERNAL)
 
-        if (failed0 || failed1)
-        {
-          double num_primitives = (double)bytes_one_thread.first;
-          std::cout << "N = " << num_primitives << ", n = " << ceilf(sqrtf(N/4.0f)) << ", "
-            "expected = " << bytes_expected/num_primitives << " B, " << 
-            "1 thread = " << bytes_one_thread.second/num_primitives << " B (" << 100.0f*expected_to_single << " %)" << (failed0 ? state->red(" [FAILED]") : "") << ", " << 
-            "all_threads = " << bytes_all_threads.second/num_primitives << " B (" << 100.0f*single_to_threaded << " %)" << (failed1 ? state->red(" [FAILED]") : "") << std::endl;
-        }
+  struct SchedulerPriorityTest : public VerifyApplication::Test
+  {
+    bool quota;
+
+    SchedulerPriorityTest (std::string name, int isa, bool quota)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), quota(quota) {}
+
+    struct Build
+    {
+      Build (RTCBuildPriority priority, size_t maxThreads, const std::atomic<bool>& release)
+        : scheduler(new TaskScheduler), started(0), release(release)
+      {
+        scheduler->setPriority(priority);
+        scheduler->setMaxThreads(maxThreads);
       }
-      return ret;
+
+      Ref<TaskScheduler> scheduler;
+      std::atomic<size_t> started;      //!< number of tasks that started
+      const std::atomic<bool>& release;
+    };
+
+    /* each thread working on the build blocks in a task until released, the remaining tasks stay stealable */
+    static void buildThread(Build* build)
+    {
+      build->scheduler->spawn_root([&] {
+          TaskScheduler::spawn(size_t(0),size_t(4),size_t(1),[&] (const range<size_t>&) {
+              build->started++;
+              while (!build->release) yield();
+            });
+          TaskScheduler::wait();
+        });
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* the pool starts no own threads, the only thread joining the builds is lent by the application */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",user_threads=1024";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      std::atomic<bool> release(false);
+      Build low (RTC_BUILD_PRIORITY_LOW,0,release);
+      Build high(RTC_BUILD_PRIORITY_HIGH,quota ? 1 : 0,release);
+      thread_t lowThread = createThread((thread_func)buildThread,&low);
+      while (low.started == 0) yield();
+      thread_t highThread = createThread((thread_func)buildThread,&high);
+      while (high.started == 0) yield();
+
+      /* the lent thread works for the build of highest priority that has a free thread slot */
+      thread_t joinThread = createThread((thread_func)join_thread_pool_thread,(RTCDevice)device,DEFAULT_STACK_SIZE);
+      while (low.started+high.started < 3) yield();
+      const bool passed = quota ? (low.started == 2 && high.started == 1) : (low.started == 1 && high.started == 2);
+
+      release = true;
+      join(lowThread);
+      join(highThread);
+      rtcLeaveDeviceThreadPool(device);
+      join(joinThread);
+      AssertNoError(device);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
     }
   };
-    
+
+#endif
+
   struct NewDeleteGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -2571,6 +3868,202 @@ namespace embree
     }
   };
     
+  struct HitCollectionTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    HitCollectionTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* stack of triangle and quad planes at z=1,2,...,8 */
+      const size_t numPlanes = 8;
+      VerifyScene scene(device,sflags);
+      for (size_t i=0; i<numPlanes; i++) {
+        const Vec3fa p0(-10.0f,-10.0f,float(i+1)), dx(20,0,0), dy(0,20,0);
+        if (i%2) scene.addGeometry(sflags.qflags,SceneGraph::createQuadPlane(p0,dx,dy,4,4));
+        else     scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(p0,dx,dy,4,4));
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* every ray collects a different maximal number of hits */
+      const size_t N = 64;
+      const unsigned maxHits = 10;
+      RTCRayHit rays[N];
+      RTCHitCollection collections[N];
+      std::vector<RTCCollectedHit> hits(N*maxHits);
+      for (size_t i=0; i<N; i++) {
+        rays[i] = makeRay(Vec3fa(18.0f*random_float()-9.0f,18.0f*random_float()-9.0f,0.0f),Vec3fa(0,0,1));
+        rays[i].ray.id = unsigned(i);
+        collections[i].hits = &hits[i*maxHits];
+        collections[i].maxHitCount = unsigned(i%maxHits);
+        collections[i].hitCount = 0;
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,N,collections);
+      AssertNoError(device);
+
+      /* hits are sorted by distance and not reported as closest hit */
+      for (size_t i=0; i<N; i++)
+      {
+        if (rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        if (collections[i].hitCount != min(collections[i].maxHitCount,unsigned(numPlanes))) return VerifyApplication::FAILED;
+        for (size_t j=0; j<collections[i].hitCount; j++) {
+          const RTCCollectedHit& hit = collections[i].hits[j];
+          if (hit.geomID != j) return VerifyApplication::FAILED;
+          if (abs(hit.t-float(j+1)) > 1E-4f) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct GeometryVisibilityTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    GeometryVisibilityTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* stack of triangle and quad planes at z=1,2,...,40, spanning multiple words of the bitset */
+      const size_t numPlanes = 40;
+      VerifyScene scene(device,sflags);
+      for (size_t i=0; i<numPlanes; i++) {
+        const Vec3fa p0(-10.0f,-10.0f,float(i+1)), dx(20,0,0), dy(0,20,0);
+        if (i%2) scene.addGeometry(sflags.qflags,SceneGraph::createQuadPlane(p0,dx,dy,4,4));
+        else     scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(p0,dx,dy,4,4));
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t numCulled : { size_t(0), size_t(1), size_t(31), size_t(33), numPlanes })
+      {
+        /* cull the first planes and a random subset of the remaining ones */
+        unsigned int visibility[(numPlanes+31)/32] = { 0 };
+        for (size_t i=numCulled; i<numPlanes; i++)
+          if (i == numCulled || random_int()%2) visibility[i/32] |= 1u << (i%32);
+
+        const size_t N = 64;
+        RTCRayHit rays[N];
+        for (size_t i=0; i<N; i++)
+          rays[i] = makeRay(Vec3fa(18.0f*random_float()-9.0f,18.0f*random_float()-9.0f,0.0f),Vec3fa(0,0,1));
+        IntersectWithMode(imode,ivariant,scene,rays,N,nullptr,visibility);
+        AssertNoError(device);
+
+        /* the closest visible plane gets hit */
+        for (size_t i=0; i<N; i++)
+        {
+          if (numCulled == numPlanes) {
+            if (rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+            continue;
+          }
+          if (rays[i].hit.geomID != numCulled) return VerifyApplication::FAILED;
+          if (abs(rays[i].ray.tfar-float(numCulled+1)) > 1E-4f) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct GeometryBackfaceCullingTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    GeometryBackfaceCullingTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* only triangle and quad meshes support backface culling */
+      RTCGeometry user = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_USER);
+      rtcSetGeometryBackfaceCulling(user,true);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      rtcReleaseGeometry(user);
+
+      /* stack of triangle and quad planes at z=1,2,3,4 facing in different directions */
+      const size_t numPlanes = 4;
+      VerifyScene scene(device,sflags);
+      for (size_t i=0; i<numPlanes; i++) {
+        const Vec3fa p0(-10.0f,-10.0f,float(i+1)), dx(20,0,0), dy(0,20,0);
+        const Vec3fa du = (i==0 || i==2) ? dx : dy;
+        const Vec3fa dv = (i==0 || i==2) ? dy : dx;
+        if (i==1 || i==2) scene.addGeometry(sflags.qflags,SceneGraph::createQuadPlane(p0,du,dv,4,4));
+        else              scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(p0,du,dv,4,4));
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* determine the orientation of each plane by isolating it with the visibility bitset */
+      bool frontFacing[numPlanes];
+      for (unsigned int i=0; i<numPlanes; i++) {
+        RTCRayHit ray = makeRay(Vec3fa(0.1f,0.2f,0.0f),Vec3fa(0,0,1));
+        const unsigned int visibility = 1u << i;
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene,&ray,1,nullptr,&visibility);
+        if (ray.hit.geomID != i) return VerifyApplication::FAILED;
+        frontFacing[i] = ray.hit.Ng_z < 0.0f;
+      }
+      if (frontFacing[0] == frontFacing[1]) return VerifyApplication::FAILED;
+
+      for (size_t mode=0; mode<4; mode++)
+      {
+        /* mode 1 culls with the geometry flag, mode 2 with the context flag, and 0 and 3 do not cull */
+        const bool geometryCulling = mode == 1;
+        for (unsigned int i=0; i<numPlanes-1; i++)
+          rtcSetGeometryBackfaceCulling(rtcGetGeometry(scene,i),geometryCulling);
+        AssertNoError(device);
+        const RTCIntersectContextFlags cflags = mode == 2 ? RTC_INTERSECT_CONTEXT_FLAG_BACKFACE_CULLING : RTC_INTERSECT_CONTEXT_FLAG_NONE;
+
+        /* half of the rays go up and half of the rays go down */
+        const size_t N = 64;
+        RTCRayHit rays[N];
+        for (size_t i=0; i<N; i++) {
+          const Vec3fa org(18.0f*random_float()-9.0f,18.0f*random_float()-9.0f,i%2 ? float(numPlanes+1) : 0.0f);
+          rays[i] = makeRay(org,Vec3fa(0,0,i%2 ? -1.0f : 1.0f));
+        }
+        IntersectWithMode(imode,ivariant,scene,rays,N,nullptr,nullptr,cflags);
+        AssertNoError(device);
+
+        /* the first plane that gets hit from the front or does not cull gets hit */
+        for (size_t i=0; i<N; i++)
+        {
+          unsigned int expected = RTC_INVALID_GEOMETRY_ID;
+          for (size_t j=0; j<numPlanes; j++) {
+            const unsigned int geomID = i%2 ? unsigned(numPlanes-1-j) : unsigned(j);
+            const bool culls = mode == 2 || (geometryCulling && geomID != numPlanes-1);
+            const bool front = i%2 ? !frontFacing[geomID] : frontFacing[geomID];
+            if (!culls || front) { expected = geomID; break; }
+          }
+          if (rays[i].hit.geomID != expected) return VerifyApplication::FAILED;
+          if (expected == RTC_INVALID_GEOMETRY_ID) continue;
+          const float t = i%2 ? float(numPlanes-expected) : float(expected+1);
+          if (abs(rays[i].ray.tfar-t) > 1E-4f) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct InactiveRaysTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
@@ -4147,6 +5640,12 @@ namespace embree
     sceneFlagsRobust.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST,        RTC_BUILD_QUALITY_LOW));
     sceneFlagsRobust.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_LOW));
 
+    sceneFlagsWatertight.push_back(SceneFlags(RTC_SCENE_FLAG_WATERTIGHT,        RTC_BUILD_QUALITY_MEDIUM));
+    sceneFlagsWatertight.push_back(SceneFlags(RTC_SCENE_FLAG_WATERTIGHT,        RTC_BUILD_QUALITY_HIGH));
+    sceneFlagsWatertight.push_back(SceneFlags(RTC_SCENE_FLAG_WATERTIGHT | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM));
+    sceneFlagsWatertight.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_WATERTIGHT,        RTC_BUILD_QUALITY_LOW));
+    sceneFlagsWatertight.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_WATERTIGHT | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_LOW));
+
     sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_LOW));
     sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST,        RTC_BUILD_QUALITY_LOW));
     sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_COMPACT,       RTC_BUILD_QUALITY_LOW));
@@ -4219,6 +5718,154 @@ namespace embree
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
       groups.pop();
+
+      push(new TestGroup("cancel_commit",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto priority : { RTC_BUILD_PRIORITY_LOW, RTC_BUILD_PRIORITY_HIGH })
+          groups.top()->add(new CancelCommitTest(to_string(sflags)+"."+std::to_string(int(priority)),isa,sflags,priority));
+      groups.pop();
+
+      push(new TestGroup("double_buffered_scene",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new DoubleBufferedSceneTest(to_string(sflags),isa,SceneFlags(RTCSceneFlags(sflags.sflags | RTC_SCENE_FLAG_DOUBLE_BUFFERED),sflags.qflags)));
+      groups.pop();
+
+      push(new TestGroup("async_commit",true,true));
+      for (auto sflags : sceneFlags) 
+        for (bool cancel : { false, true })
+          groups.top()->add(new AsyncCommitTest(to_string(sflags)+(cancel ? ".cancel" : ""),isa,sflags,cancel));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new AsyncCommitReleaseTest(to_string(sflags)+".release",isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("allocator",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new AllocatorTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("build_arena",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new BuildArenaTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("transparent_hugepages",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new TransparentHugePagesTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASKING_SYSTEM) == 0)
+      {
+        /* joined threads would also work on the tasks running the tests of a parallel group */
+        push(new TestGroup("thread_pool_join",true,false));
+        for (auto sflags : sceneFlags) 
+          groups.top()->add(new ThreadPoolJoinTest(to_string(sflags),isa,sflags));
+        groups.top()->add(new ThreadPoolLeaveTest("leave",isa));
+        groups.pop();
+      }
+
+#if defined(TASKING_INTERNAL)
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TASKING_SYSTEM) == 0)
+      {
+        push(new TestGroup("scheduler_priority",true,false));
+        groups.top()->add(new SchedulerPriorityTest("priority",isa,false));
+        groups.top()->add(new SchedulerPriorityTest("quota",isa,true));
+        groups.pop();
+      }
+#endif
+
+      push(new TestGroup("hlbvh_build",true,true));
+      for (auto sflags : sceneFlags) 
+        for (size_t treeletSize : { 4, 64, 1024 })
+          groups.top()->add(new BuilderConfigTest(to_string(sflags)+"."+std::to_string(treeletSize),isa,sflags,"tri_builder=hlbvh,hlbvh_treelet_size="+std::to_string(treeletSize)));
+      /* two level builds use the HLBVH builder for large low quality meshes */
+      for (auto sflags : sceneFlags) 
+        for (size_t treeletSize : { 4, 64, 1024 })
+          groups.top()->add(new BuilderConfigTest("twolevel."+to_string(sflags)+"."+std::to_string(treeletSize),isa,sflags,"tri_builder=dynamic,hlbvh_treelet_size="+std::to_string(treeletSize)));
+      groups.pop();
+
+      push(new TestGroup("scene_time_range",true,true));
+      for (auto sflags : sceneFlags) 
+        for (size_t numTimeSteps : { 2, 5, 33 })
+          groups.top()->add(new SceneTimeRangeTest(to_string(sflags)+"."+std::to_string(numTimeSteps),isa,sflags,numTimeSteps));
+      groups.pop();
+
+      push(new TestGroup("geometry_time_steps",true,true));
+      for (auto sflags : sceneFlags) 
+        for (size_t numTimeSteps : { 2, 5, 33 })
+          for (bool nonuniform : { false, true })
+            groups.top()->add(new GeometryTimeStepsTest(to_string(sflags)+"."+std::to_string(numTimeSteps)+(nonuniform ? ".nonuniform" : ".uniform"),isa,sflags,numTimeSteps,nonuniform));
+      groups.pop();
+
+      push(new TestGroup("point_query",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("hit_collection",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant) && (ivariant & VARIANT_INTERSECT_OCCLUDED) == VARIANT_INTERSECT)
+              groups.top()->add(new HitCollectionTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("geometry_visibility",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant) && (ivariant & VARIANT_INTERSECT))
+              groups.top()->add(new GeometryVisibilityTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
+      if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_BACKFACE_CULLING_ENABLED))
+      {
+        push(new TestGroup("geometry_backface_culling",true,true));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant) && (ivariant & VARIANT_INTERSECT))
+                groups.top()->add(new GeometryBackfaceCullingTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+        groups.pop();
+      }
+
+      push(new TestGroup("coherent_shadow_stream",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new CoherentShadowStreamTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("reduced_hit",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new ReducedHitTest(to_string(sflags)+".coherent",isa,sflags,RTC_INTERSECT_CONTEXT_FLAG_COHERENT));
+        groups.top()->add(new ReducedHitTest(to_string(sflags)+".incoherent",isa,sflags,RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT));
+      }
+      groups.pop();
+
+      push(new TestGroup("traversal_statistics",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new TraversalStatisticsTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("lod_cone",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new LodConeTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("quaternion_instance",true,true));
+      for (auto sflags : sceneFlags) 
+        for (size_t numTimeSteps : { 2, 3, 8 })
+          groups.top()->add(new QuaternionInstanceTest(to_string(sflags)+"."+std::to_string(numTimeSteps),isa,sflags,numTimeSteps));
+      groups.pop();
+
+      push(new TestGroup("double_origin_instance",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new DoubleOriginInstanceTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("spatial_split_budget",true,true));
+      for (auto sflags : { SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_HIGH), SceneFlags(RTC_SCENE_FLAG_ROBUST,RTC_BUILD_QUALITY_HIGH) })
+        for (std::string replications : { "1.5", "2", "4" })
+          groups.top()->add(new BuilderConfigTest(to_string(sflags)+".x"+replications,isa,sflags,"spatial_split_budget=1,max_spatial_split_replications="+replications));
+      groups.pop();
       
       push(new TestGroup("overlapping_primitives",true,true));
       for (auto sflags : sceneFlags)
@@ -4371,6 +6018,11 @@ namespace embree
           for (auto imode : intersectModes) 
             for (std::string model : watertightModels) 
               groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,watertight_pos));
+        /* watertight mode keeps the fast traversal, which is only accurate close to the origin */
+        for (auto sflags : sceneFlagsWatertight) 
+          for (auto imode : intersectModes) 
+            for (std::string model : watertightModels) 
+              groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,Vec3fa(1.0f,2.0f,-3.0f)));
         groups.pop();
       }
 
@@ -4381,6 +6033,11 @@ namespace embree
           for (auto imode : intersectModes) 
             for (std::string model : watertightModels) 
               groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,watertight_pos));
+        /* watertight mode keeps the fast traversal, which is only accurate close to the origin */
+        for (auto sflags : sceneFlagsWatertight) 
+          for (auto imode : intersectModes) 
+            for (std::string model : watertightModels) 
+              groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,Vec3fa(1.0f,2.0f,-3.0f)));
         groups.pop();
       }
 
@@ -4391,6 +6048,11 @@ namespace embree
           for (auto imode : intersectModes) 
             for (std::string model : watertightModels) 
               groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,watertight_pos));
+        /* watertight mode keeps the fast traversal, which is only accurate close to the origin */
+        for (auto sflags : sceneFlagsWatertight) 
+          for (auto imode : intersectModes) 
+            for (std::string model : watertightModels) 
+              groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,Vec3fa(1.0f,2.0f,-3.0f)));
         groups.pop();
       }
 
@@ -4401,6 +6063,11 @@ namespace embree
           for (auto imode : intersectModes) 
             for (std::string model : watertightModels) 
               groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,watertight_pos));
+        /* watertight mode keeps the fast traversal, which is only accurate close to the origin */
+        for (auto sflags : sceneFlagsWatertight) 
+          for (auto imode : intersectModes) 
+            for (std::string model : watertightModels) 
+              groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,Vec3fa(1.0f,2.0f,-3.0f)));
         groups.pop();
       }
 
@@ -173,6 +173,7 @@ namespace embree
     RTCDeviceRef device;
     std::vector<SceneFlags> sceneFlags;
     std::vector<SceneFlags> sceneFlagsRobust;
+    std::vector<SceneFlags> sceneFlagsWatertight;
     std::vector<SceneFlags> sceneFlagsDynamic;
     std::vector<IntersectMode> intersectModes;
     std::vector<IntersectVariant> intersectVariants;